@@ -0,0 +1,48 @@
+@echo off
+rem $ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $
+
+rem Compiles the SingletonUtilMass plugin against this checkout of SingletonUtil. The engine never discovers a plugin
+rem nested inside another one, so both are staged side by side in a temporary host project whose editor target is built.
+rem Run it before shipping changes to either plugin, the main plugin alone never compiles the bridge.
+rem
+rem Usage: Extras\BuildSingletonUtilMass.bat <EngineRoot> [Configuration]
+
+setlocal
+
+if "%~1"=="" (
+	echo Usage: %~nx0 ^<EngineRoot^> [Configuration]
+	exit /b 1
+)
+set "ENGINE_ROOT=%~1"
+set "CONFIGURATION=%~2"
+if "%CONFIGURATION%"=="" set "CONFIGURATION=Development"
+
+set "REPO_DIR=%~dp0.."
+set "STAGING_DIR=%TEMP%\SdMassHost_%RANDOM%"
+set "HOST_DIR=%STAGING_DIR%\SdMassHost"
+
+rem the main plugin is staged without its extras, they would not be discovered there either
+robocopy "%REPO_DIR%" "%HOST_DIR%\Plugins\SingletonUtil" /E /NFL /NDL /NJH /NJS /XD .git Extras Binaries Intermediate >nul
+if %ERRORLEVEL% GEQ 8 goto :failed
+robocopy "%REPO_DIR%\Extras\SingletonUtilMass" "%HOST_DIR%\Plugins\SingletonUtilMass" /E /NFL /NDL /NJH /NJS /XD Binaries Intermediate >nul
+if %ERRORLEVEL% GEQ 8 goto :failed
+
+(
+	echo {
+	echo 	"FileVersion": 3,
+	echo 	"Plugins": [
+	echo 		{ "Name": "SingletonUtil", "Enabled": true },
+	echo 		{ "Name": "SingletonUtilMass", "Enabled": true }
+	echo 	]
+	echo }
+) > "%HOST_DIR%\SdMassHost.uproject"
+
+call "%ENGINE_ROOT%\Engine\Build\BatchFiles\RunUBT.bat" UnrealEditor Win64 %CONFIGURATION% -Project="%HOST_DIR%\SdMassHost.uproject" -WaitMutex -NoHotReload
+set "BUILD_RESULT=%ERRORLEVEL%"
+rmdir /S /Q "%STAGING_DIR%"
+exit /b %BUILD_RESULT%
+
+:failed
+echo Staging the host project failed
+rmdir /S /Q "%STAGING_DIR%"
+exit /b 1
@@ -0,0 +1,42 @@
+#!/usr/bin/env bash
+#$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $#
+
+# Compiles the SingletonUtilMass plugin against this checkout of SingletonUtil. The engine never discovers a plugin
+# nested inside another one, so both are staged side by side in a temporary host project whose editor target is built.
+# Run it before shipping changes to either plugin, the main plugin alone never compiles the bridge.
+#
+# Usage: Extras/BuildSingletonUtilMass.sh <EngineRoot> [Platform] [Configuration]
+
+set -euo pipefail
+
+ENGINE_ROOT="${1:?Usage: $0 <EngineRoot> [Platform] [Configuration]}"
+if [ "$(uname)" = "Darwin" ]; then
+	DEFAULT_PLATFORM="Mac"
+else
+	DEFAULT_PLATFORM="Linux"
+fi
+PLATFORM="${2:-$DEFAULT_PLATFORM}"
+CONFIGURATION="${3:-Development}"
+
+REPO_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+STAGING_DIR="$(mktemp -d)"
+trap 'rm -rf "$STAGING_DIR"' EXIT
+
+HOST_DIR="$STAGING_DIR/SdMassHost"
+mkdir -p "$HOST_DIR/Plugins"
+
+# the main plugin is staged without its extras, they would not be discovered there either
+rsync -a --exclude ".git" --exclude "Extras" --exclude "Binaries" --exclude "Intermediate" "$REPO_DIR/" "$HOST_DIR/Plugins/SingletonUtil/"
+rsync -a --exclude "Binaries" --exclude "Intermediate" "$REPO_DIR/Extras/SingletonUtilMass/" "$HOST_DIR/Plugins/SingletonUtilMass/"
+
+cat > "$HOST_DIR/SdMassHost.uproject" <<UPROJECT
+{
+	"FileVersion": 3,
+	"Plugins": [
+		{ "Name": "SingletonUtil", "Enabled": true },
+		{ "Name": "SingletonUtilMass", "Enabled": true }
+	]
+}
+UPROJECT
+
+"$ENGINE_ROOT/Engine/Build/BatchFiles/RunUBT.sh" UnrealEditor "$PLATFORM" "$CONFIGURATION" -Project="$HOST_DIR/SdMassHost.uproject" -WaitMutex -NoHotReload
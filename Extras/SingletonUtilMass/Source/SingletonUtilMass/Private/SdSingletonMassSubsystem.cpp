@@ -0,0 +1,85 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdSingletonMassSubsystem.h"
+#include "SdSingletonSubsystem.h"
+
+#include "Engine/World.h"
+#include "UObject/UObjectGlobals.h"
+
+
+void USdSingletonMassSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Collection.InitializeDependency<USdSingletonSubsystem>();
+	Super::Initialize(Collection);
+
+	PostReachabilityAnalysisHandle = FCoreUObjectDelegates::PostReachabilityAnalysis.AddUObject(this, &USdSingletonMassSubsystem::OnPostReachabilityAnalysis);
+}
+
+void USdSingletonMassSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostReachabilityAnalysis.Remove(PostReachabilityAnalysisHandle);
+	PostReachabilityAnalysisHandle.Reset();
+
+	USdSingletonSubsystem* SingletonSubsystem = GetWorld()->GetSubsystem<USdSingletonSubsystem>();
+	for (auto& PublishedItx : PublishedSingletons)
+	{
+		if (SingletonSubsystem)
+		{
+			SingletonSubsystem->RemoveSingletonAvailabilityHandler(PublishedItx.Key.ResolveObjectPtr(), PublishedItx.Value->AvailabilityHandle);
+		}
+		PublishedItx.Value->Singleton.store(nullptr, std::memory_order_release);
+	}
+	PublishedSingletons.Empty();
+	Super::Deinitialize();
+}
+
+void USdSingletonMassSubsystem::OnPostReachabilityAnalysis()
+{
+	// components and global objects can disappear without an availability event, weak pointers already
+	// report unreachable objects at this point while their memory is still intact. No processor runs during GC
+	for (auto& PublishedItx : PublishedSingletons)
+	{
+		FPublishedSingleton& Published = *PublishedItx.Value;
+		if (!Published.WeakSingleton.IsValid())
+		{
+			Published.WeakSingleton.Reset();
+			Published.Singleton.store(nullptr, std::memory_order_release);
+		}
+	}
+}
+
+FSdMassSingletonHandle USdSingletonMassSubsystem::PublishSingleton(const UClass* InKey)
+{
+	check(IsInGameThread());
+
+	FSdMassSingletonHandle Handle;
+	if (!IsValid(InKey))
+	{
+		return Handle;
+	}
+
+	if (const TUniquePtr<FPublishedSingleton>* ExistingSingleton = PublishedSingletons.Find(TObjectKey<UClass>(InKey)))
+	{
+		Handle.Slot = &(*ExistingSingleton)->Singleton;
+		return Handle;
+	}
+
+	USdSingletonSubsystem* SingletonSubsystem = GetWorld()->GetSubsystem<USdSingletonSubsystem>();
+	if (!SingletonSubsystem)
+	{
+		return Handle;
+	}
+
+	FPublishedSingleton* Published = PublishedSingletons.Add(TObjectKey<UClass>(InKey), MakeUnique<FPublishedSingleton>()).Get();
+	Handle.Slot = &Published->Singleton;
+
+	// fires right away when the singleton already exists, the slot is only ever written here on the game thread
+	Published->AvailabilityHandle = SingletonSubsystem->AddSingletonAvailabilityHandler(InKey, FSdOnSingletonAvailabilityNative::FDelegate::CreateWeakLambda(this, [Published](UObject* InSingleton, bool bAvailable)
+		{
+			UObject* PublishedSingleton = bAvailable ? InSingleton : nullptr;
+			Published->WeakSingleton = PublishedSingleton;
+			Published->Singleton.store(PublishedSingleton, std::memory_order_release);
+		}));
+	return Handle;
+}
@@ -0,0 +1,17 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#include "SingletonUtilMass.h"
+
+#define LOCTEXT_NAMESPACE "FSingletonUtilMassModule"
+
+void FSingletonUtilMassModule::StartupModule()
+{
+}
+
+void FSingletonUtilMassModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FSingletonUtilMassModule, SingletonUtilMass)
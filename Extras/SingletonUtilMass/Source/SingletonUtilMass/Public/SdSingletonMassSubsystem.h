@@ -0,0 +1,97 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassExternalSubsystemTraits.h"
+#include "UObject/ObjectKey.h"
+#include <atomic>
+#include "SdSingletonMassSubsystem.generated.h"
+
+/**
+ * Prefetched singleton pointer for Mass processors. Reading it is a single atomic load, no lookup, and is safe from
+ * any processing thread. The pointer is kept up to date on the game thread as the singleton is spawned, found or destroyed,
+ * and is cleared before a singleton that became unreachable is garbage collected.
+ */
+struct FSdMassSingletonHandle
+{
+	bool IsValid() const { return Slot != nullptr; }
+
+	UObject* GetObject() const
+	{
+		return Slot ? Slot->load(std::memory_order_acquire) : nullptr;
+	}
+
+	// T must be the published class or one of its bases
+	template <typename T>
+	T* Get() const
+	{
+		static_assert(TIsDerivedFrom<T, UObject>::Value, "FSdMassSingletonHandle::Get only supports UObject types, use GetObject for interfaces");
+		return static_cast<T*>(GetObject());
+	}
+
+private:
+	friend class USdSingletonMassSubsystem;
+
+	const std::atomic<UObject*>* Slot = nullptr;
+};
+
+/**
+ * Publishes singletons resolved through USdSingletonSubsystem to Mass processors.
+ * Publish a singleton class once while the processor initializes, declare the subsystem as a read only requirement
+ * of the processor's queries, and read the handle in Execute. Processors never call into the singleton caches.
+ */
+UCLASS()
+class SINGLETONUTILMASS_API USdSingletonMassSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Starts publishing the singleton of an actor, component or interface class. Game thread only.
+	 * Publishing the same class again returns the same handle.
+	 * @param InKey - The singleton class to publish.
+	 * @return The handle processors read the singleton through, valid for the lifetime of this subsystem.
+	 */
+	FSdMassSingletonHandle PublishSingleton(const UClass* InKey);
+
+	template <typename T>
+	FSdMassSingletonHandle PublishSingleton()
+	{
+		return PublishSingleton(T::StaticClass());
+	}
+
+private:
+	struct FPublishedSingleton
+	{
+		// Read by processors, holds no reference
+		std::atomic<UObject*> Singleton{ nullptr };
+
+		// Tells whether the object behind Singleton is still alive, game thread only
+		TWeakObjectPtr<UObject> WeakSingleton;
+
+		FDelegateHandle AvailabilityHandle;
+	};
+
+	// Clears the slots of singletons about to be purged, before their memory can be reused
+	void OnPostReachabilityAnalysis();
+
+	FDelegateHandle PostReachabilityAnalysisHandle;
+
+	// Boxed, so handles keep pointing at their slot when more classes are published
+	TMap<TObjectKey<UClass>, TUniquePtr<FPublishedSingleton>> PublishedSingletons;
+};
+
+template <>
+struct TMassExternalSubsystemTraits<USdSingletonMassSubsystem> final
+{
+	enum
+	{
+		GameThreadOnly = false,
+		ThreadSafeWrite = false,
+	};
+};
@@ -0,0 +1,29 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+using UnrealBuildTool;
+
+public class SingletonUtilMass : ModuleRules
+{
+	public SingletonUtilMass(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"MassEntity",
+			}
+			);
+			
+		
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"SingletonUtil",
+			}
+			);
+	}
+}
@@ -0,0 +1,182 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#include "GameplayDebuggerCategory_SdSingleton.h"
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "SdSingletonSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+
+FGameplayDebuggerCategory_SdSingleton::FGameplayDebuggerCategory_SdSingleton()
+{
+	bShowOnlyWithDebugActor = false;
+	SetDataPackReplication<FRepData>(&DataPack);
+}
+
+TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_SdSingleton::MakeInstance()
+{
+	return MakeShareable(new FGameplayDebuggerCategory_SdSingleton());
+}
+
+void FGameplayDebuggerCategory_SdSingleton::FRepData::Serialize(FArchive& Ar)
+{
+	int32 NumCaches = Caches.Num();
+	Ar << NumCaches;
+	if (Ar.IsLoading())
+	{
+		Caches.SetNum(NumCaches);
+	}
+	for (FCacheData& CacheData : Caches)
+	{
+		Ar << CacheData.CacheName;
+		Ar << CacheData.NumEntries;
+		Ar << CacheData.NumStaleEntries;
+		Ar << CacheData.AllocatedBytes;
+		Ar << CacheData.HitRate;
+	}
+
+	int32 NumEntries = Entries.Num();
+	Ar << NumEntries;
+	if (Ar.IsLoading())
+	{
+		Entries.SetNum(NumEntries);
+	}
+	for (FEntryData& EntryData : Entries)
+	{
+		Ar << EntryData.CacheName;
+		Ar << EntryData.KeyName;
+		Ar << EntryData.ObjectName;
+		Ar << EntryData.bTracksAccess;
+		Ar << EntryData.Hits;
+		Ar << EntryData.FramesSinceAccess;
+		Ar << EntryData.ScanMilliseconds;
+	}
+
+	Ar << NumTotalEntries;
+}
+
+void FGameplayDebuggerCategory_SdSingleton::CollectData(APlayerController* OwnerPC, AActor* DebugActor)
+{
+	DataPack.Caches.Reset();
+	DataPack.Entries.Reset();
+	DataPack.NumTotalEntries = 0;
+
+	UWorld*				   World = OwnerPC ? OwnerPC->GetWorld() : nullptr;
+	USdSingletonSubsystem* SingletonSubsystem = World ? World->GetSubsystem<USdSingletonSubsystem>() : nullptr;
+	if (!SingletonSubsystem)
+	{
+		return;
+	}
+
+	for (const FSdSingletonCacheStats& CacheStats : SingletonSubsystem->GetCacheStats())
+	{
+		FCacheData& CacheData = DataPack.Caches.AddDefaulted_GetRef();
+		CacheData.CacheName = CacheStats.CacheName.ToString();
+		CacheData.NumEntries = CacheStats.NumEntries;
+		CacheData.NumStaleEntries = CacheStats.NumStaleEntries;
+		CacheData.AllocatedBytes = CacheStats.AllocatedBytes;
+		CacheData.HitRate = CacheStats.GetHitRate();
+	}
+
+	// keep only the most recently accessed entries in a fixed size buffer, strings are built for those alone
+	struct FRecentEntry
+	{
+		const FSdSingletonCacheEntry*		 Entry = nullptr;
+		FName								 CacheName;
+		const UClass*						 KeyClass = nullptr;
+		const FSD_SingletonInterfaceHashKey* InterfaceHashKey = nullptr;
+		FName								 GlobalId = NAME_None;
+		const UObject*						 Object = nullptr;
+		int32								 NumDerivedClasses = INDEX_NONE;
+
+		// entries without access tracking sort after every tracked one
+		uint64 GetLastAccessFrame() const
+		{
+			return Entry ? Entry->LastAccessFrame : 0;
+		}
+	};
+	TArray<FRecentEntry, TInlineAllocator<MaxDisplayedEntries>> RecentEntries;
+
+	SingletonSubsystem->ForEachCacheEntry([&RecentEntries, this](const FSdSingletonCacheEntryView& EntryView)
+		{
+			DataPack.NumTotalEntries++;
+
+			const uint64 LastAccessFrame = EntryView.Entry ? EntryView.Entry->LastAccessFrame : 0;
+			int32		 InsertIndex = RecentEntries.Num();
+			while (InsertIndex > 0 && RecentEntries[InsertIndex - 1].GetLastAccessFrame() < LastAccessFrame)
+			{
+				InsertIndex--;
+			}
+			if (InsertIndex >= MaxDisplayedEntries)
+			{
+				return;
+			}
+			if (RecentEntries.Num() == MaxDisplayedEntries)
+			{
+				RecentEntries.Pop();
+			}
+			const int32 NumDerivedClasses = EntryView.DerivedClasses ? EntryView.DerivedClasses->Num() : INDEX_NONE;
+			RecentEntries.Insert(FRecentEntry{ EntryView.Entry, EntryView.CacheName, EntryView.KeyClass, EntryView.InterfaceHashKey, EntryView.GlobalId, EntryView.Object, NumDerivedClasses }, InsertIndex);
+		});
+
+	for (const FRecentEntry& RecentEntry : RecentEntries)
+	{
+		FEntryData& EntryData = DataPack.Entries.AddDefaulted_GetRef();
+		EntryData.CacheName = RecentEntry.CacheName.ToString();
+		if (RecentEntry.InterfaceHashKey)
+		{
+			EntryData.KeyName = RecentEntry.InterfaceHashKey->GetHashKeyDisplayName();
+		}
+		else
+		{
+			EntryData.KeyName = GetNameSafe(RecentEntry.KeyClass);
+			if (RecentEntry.GlobalId != NAME_None)
+			{
+				EntryData.KeyName += TEXT("_") + RecentEntry.GlobalId.ToString();
+			}
+		}
+
+		if (RecentEntry.NumDerivedClasses != INDEX_NONE)
+		{
+			EntryData.ObjectName = FString::Printf(TEXT("%d derived classes"), RecentEntry.NumDerivedClasses);
+		}
+		else
+		{
+			EntryData.ObjectName = IsValid(RecentEntry.Object) ? RecentEntry.Object->GetName() : FString(TEXT("<stale>"));
+		}
+
+		if (RecentEntry.Entry)
+		{
+			EntryData.bTracksAccess = true;
+			EntryData.Hits = RecentEntry.Entry->Hits;
+			EntryData.FramesSinceAccess = GFrameCounter - RecentEntry.Entry->LastAccessFrame;
+			EntryData.ScanMilliseconds = RecentEntry.Entry->ScanMilliseconds;
+		}
+	}
+}
+
+void FGameplayDebuggerCategory_SdSingleton::DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext)
+{
+	for (const FCacheData& CacheData : DataPack.Caches)
+	{
+		CanvasContext.Printf(TEXT("{yellow}%s{white}: %d entries, {red}%d stale{white}, %lld bytes, %.1f%% hits"), *CacheData.CacheName, CacheData.NumEntries, CacheData.NumStaleEntries, CacheData.AllocatedBytes, CacheData.HitRate * 100.f);
+	}
+
+	CanvasContext.Printf(TEXT(""));
+	CanvasContext.Printf(TEXT("{green}Most recently accessed entries (%d of %d):"), DataPack.Entries.Num(), DataPack.NumTotalEntries);
+	for (const FEntryData& EntryData : DataPack.Entries)
+	{
+		if (EntryData.bTracksAccess)
+		{
+			CanvasContext.Printf(TEXT("{grey}[%s] {white}%s -> {cyan}%s{white}  hits %u, %llu frames ago, scan %.3f ms"), *EntryData.CacheName, *EntryData.KeyName, *EntryData.ObjectName, EntryData.Hits, EntryData.FramesSinceAccess, EntryData.ScanMilliseconds);
+		}
+		else
+		{
+			CanvasContext.Printf(TEXT("{grey}[%s] {white}%s -> {cyan}%s"), *EntryData.CacheName, *EntryData.KeyName, *EntryData.ObjectName);
+		}
+	}
+}
+
+#endif // WITH_GAMEPLAY_DEBUGGER
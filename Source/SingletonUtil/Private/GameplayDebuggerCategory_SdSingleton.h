@@ -0,0 +1,60 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#if WITH_GAMEPLAY_DEBUGGER
+
+#include "CoreMinimal.h"
+#include "GameplayDebuggerCategory.h"
+
+/**
+ * Gameplay Debugger category streaming the live state of the USdSingletonSubsystem caches of the debugged world.
+ * Data is collected on the server (dedicated servers included) and replicated to the debugging client.
+ */
+class FGameplayDebuggerCategory_SdSingleton : public FGameplayDebuggerCategory
+{
+public:
+	FGameplayDebuggerCategory_SdSingleton();
+
+	virtual void CollectData(APlayerController* OwnerPC, AActor* DebugActor) override;
+	virtual void DrawData(APlayerController* OwnerPC, FGameplayDebuggerCanvasContext& CanvasContext) override;
+
+	static TSharedRef<FGameplayDebuggerCategory> MakeInstance();
+
+protected:
+	// Most recently accessed entries shown per collection, registry and derived class entries fill the remaining rows
+	static constexpr int32 MaxDisplayedEntries = 24;
+
+	struct FEntryData
+	{
+		FString CacheName;
+		FString KeyName;
+		FString ObjectName;
+		bool	bTracksAccess = false;
+		uint32	Hits = 0;
+		uint64	FramesSinceAccess = 0;
+		float	ScanMilliseconds = 0.f;
+	};
+
+	struct FCacheData
+	{
+		FString CacheName;
+		int32	NumEntries = 0;
+		int32	NumStaleEntries = 0;
+		int64	AllocatedBytes = 0;
+		float	HitRate = 0.f;
+	};
+
+	struct FRepData
+	{
+		TArray<FCacheData> Caches;
+		TArray<FEntryData> Entries;
+		int32			   NumTotalEntries = 0;
+
+		void Serialize(FArchive& Ar);
+	};
+
+	FRepData DataPack;
+};
+
+#endif // WITH_GAMEPLAY_DEBUGGER
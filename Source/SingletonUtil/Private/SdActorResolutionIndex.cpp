@@ -0,0 +1,236 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdActorResolutionIndex.h"
+#include "SdSingletonClassMetadata.h"
+
+#include "GameFramework/Actor.h"
+
+
+namespace SdActorResolution
+{
+	constexpr uint64 SerialBits = 40;
+	constexpr uint64 SerialMask = (uint64(1) << SerialBits) - 1;
+	constexpr uint64 DepthMask = 0xFFFF;
+
+	// earlier spawns rank higher
+	static uint64 InvertSerial(uint64 Serial)
+	{
+		return SerialMask - FMath::Min(Serial, SerialMask);
+	}
+} // namespace SdActorResolution
+
+AActor* FSdActorResolutionIndex::FindPreferredActor(const UClass* InClass)
+{
+	const TObjectKey<UClass> ClassKey(InClass);
+	FCandidate*				 Candidate = PreferredActors.Find(ClassKey);
+	if (!Candidate)
+	{
+		return nullptr;
+	}
+
+	if (TArray<FTrackedActor>* TrackedActors = TaggedCandidates.Find(ClassKey))
+	{
+		// candidates are picked in the order they were found, so destroyed ones are dropped without reordering the rest
+		Candidate->Actor.Reset();
+		TrackedActors->RemoveAll([](const FTrackedActor& TrackedActor) { return !IsValid(TrackedActor.Actor.Get()); });
+		for (const FTrackedActor& TrackedActor : *TrackedActors)
+		{
+			AActor* Actor = TrackedActor.Actor.Get();
+			if (ReplacesCandidate(*Candidate, Actor, ESdActorResolutionPolicy::Tagged, TrackedActor.Serial))
+			{
+				SetCandidate(*Candidate, Actor, ESdActorResolutionPolicy::Tagged, TrackedActor.Serial);
+			}
+		}
+	}
+
+	AActor* PreferredActor = Candidate->Actor.Get();
+	return IsValid(PreferredActor) ? PreferredActor : nullptr;
+}
+
+AActor* FSdActorResolutionIndex::ResolveFromCandidates(const UClass* InClass, TConstArrayView<AActor*> Candidates)
+{
+	const TObjectKey<UClass>	   ClassKey(InClass);
+	const ESdActorResolutionPolicy Policy = GetPolicy(InClass);
+
+	TArray<FTrackedActor>* TrackedActors = nullptr;
+	if (Policy == ESdActorResolutionPolicy::Tagged)
+	{
+		TrackedActors = &TaggedCandidates.Add(ClassKey);
+		TrackedActors->Reserve(Candidates.Num());
+	}
+
+	FCandidate BestCandidate;
+	for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+	{
+		AActor* Candidate = Candidates[Index];
+		if (!IsValid(Candidate))
+		{
+			continue;
+		}
+		if (TrackedActors)
+		{
+			TrackedActors->Add(FTrackedActor{ Candidate, uint64(Index) });
+		}
+		if (ReplacesCandidate(BestCandidate, Candidate, Policy, Index))
+		{
+			SetCandidate(BestCandidate, Candidate, Policy, Index);
+		}
+	}
+
+	AActor* BestActor = BestCandidate.Actor.Get();
+	PreferredActors.Add(ClassKey, BestCandidate);
+	return BestActor;
+}
+
+void FSdActorResolutionIndex::OnActorSpawned(AActor* InActor)
+{
+	if (!IsValid(InActor) || PreferredActors.Num() == 0)
+	{
+		return;
+	}
+
+	const uint64 Serial = NextSpawnSerial++;
+	for (const UClass* Class = InActor->GetClass(); Class; Class = Class->GetSuperClass())
+	{
+		const TObjectKey<UClass> ClassKey(Class);
+		FCandidate*				 Candidate = PreferredActors.Find(ClassKey);
+
+		// a destroyed candidate leaves the class to be scanned again, the candidates before it decide the result
+		if (Candidate && Candidate->Actor.IsStale())
+		{
+			PreferredActors.Remove(ClassKey);
+			TaggedCandidates.Remove(ClassKey);
+		}
+		else if (Candidate)
+		{
+			const ESdActorResolutionPolicy Policy = GetPolicy(Class);
+			if (ReplacesCandidate(*Candidate, InActor, Policy, Serial))
+			{
+				SetCandidate(*Candidate, InActor, Policy, Serial);
+			}
+			if (TArray<FTrackedActor>* TrackedActors = TaggedCandidates.Find(ClassKey))
+			{
+				TrackedActors->Add(FTrackedActor{ InActor, Serial });
+			}
+		}
+		if (Class == AActor::StaticClass())
+		{
+			break;
+		}
+	}
+}
+
+void FSdActorResolutionIndex::InvalidateActorClass(const UClass* InActorClass)
+{
+	for (const UClass* Class = InActorClass; Class; Class = Class->GetSuperClass())
+	{
+		const TObjectKey<UClass> ClassKey(Class);
+		PreferredActors.Remove(ClassKey);
+		TaggedCandidates.Remove(ClassKey);
+		if (Class == AActor::StaticClass())
+		{
+			break;
+		}
+	}
+}
+
+uint64 FSdActorResolutionIndex::RankActor(const AActor* InActor, ESdActorResolutionPolicy InPolicy, uint64 InSerial) const
+{
+	using namespace SdActorResolution;
+
+	const uint64 Earliness = InvertSerial(InSerial);
+	if (InPolicy == ESdActorResolutionPolicy::FirstSpawned)
+	{
+		return Earliness;
+	}
+
+	const uint64 Depth = uint64(FSdSingletonClassMetadata::Get().GetClassDepth(InActor->GetClass())) & DepthMask;
+	const bool	 bHasRootComponent = IsValid(InActor->GetRootComponent());
+	return (Depth << (SerialBits + 1)) | (uint64(bHasRootComponent) << SerialBits) | Earliness;
+}
+
+bool FSdActorResolutionIndex::ReplacesCandidate(const FCandidate& InCandidate, const AActor* InActor, ESdActorResolutionPolicy InPolicy, uint64 InSerial) const
+{
+	const AActor* CandidateActor = InCandidate.Actor.Get();
+	if (!IsValid(CandidateActor))
+	{
+		return true;
+	}
+
+	switch (InPolicy)
+	{
+		case ESdActorResolutionPolicy::DeepestDescendant:
+		case ESdActorResolutionPolicy::FirstSpawned:
+			return RankActor(InActor, InPolicy, InSerial) > InCandidate.Rank;
+		case ESdActorResolutionPolicy::Tagged:
+		{
+			const bool bTagged = InActor->ActorHasTag(PreferredActorTag);
+			if (bTagged != CandidateActor->ActorHasTag(PreferredActorTag))
+			{
+				return bTagged;
+			}
+			break;
+		}
+		case ESdActorResolutionPolicy::HasRootComponent:
+		default:
+			break;
+	}
+
+	// the original loop: the first actor with a root component ends the search, until then the backup is the first actor
+	// found and is replaced by every later one of the same or a derived class
+	if (IsValid(CandidateActor->GetRootComponent()))
+	{
+		return false;
+	}
+	return IsValid(InActor->GetRootComponent()) || InActor->GetClass()->IsChildOf(CandidateActor->GetClass());
+}
+
+void FSdActorResolutionIndex::SetCandidate(FCandidate& OutCandidate, AActor* InActor, ESdActorResolutionPolicy InPolicy, uint64 InSerial) const
+{
+	OutCandidate.Actor = InActor;
+	const bool bRanked = InPolicy == ESdActorResolutionPolicy::DeepestDescendant || InPolicy == ESdActorResolutionPolicy::FirstSpawned;
+	OutCandidate.Rank = bRanked ? RankActor(InActor, InPolicy, InSerial) : 0;
+}
+
+ESdActorResolutionPolicy FSdActorResolutionIndex::GetPolicy(const UClass* InClass) const
+{
+	const ESdActorResolutionPolicy* Policy = PolicyOverrides.Find(TObjectKey<UClass>(InClass));
+	return Policy ? *Policy : DefaultPolicy;
+}
+
+void FSdActorResolutionIndex::SetPolicy(const UClass* InClass, ESdActorResolutionPolicy InPolicy)
+{
+	const TObjectKey<UClass> ClassKey(InClass);
+	PolicyOverrides.Add(ClassKey, InPolicy);
+	PreferredActors.Remove(ClassKey);
+	TaggedCandidates.Remove(ClassKey);
+}
+
+void FSdActorResolutionIndex::SetDefaultPolicy(ESdActorResolutionPolicy InPolicy)
+{
+	DefaultPolicy = InPolicy;
+	Reset();
+}
+
+void FSdActorResolutionIndex::SetPreferredActorTag(FName InTag)
+{
+	PreferredActorTag = InTag;
+	Reset();
+}
+
+void FSdActorResolutionIndex::Reset()
+{
+	PreferredActors.Empty();
+	TaggedCandidates.Empty();
+}
+
+SIZE_T FSdActorResolutionIndex::GetAllocatedSize() const
+{
+	SIZE_T OutBytes = PreferredActors.GetAllocatedSize() + TaggedCandidates.GetAllocatedSize() + PolicyOverrides.GetAllocatedSize();
+	for (const auto& MapItx : TaggedCandidates)
+	{
+		OutBytes += MapItx.Value.GetAllocatedSize();
+	}
+	return OutBytes;
+}
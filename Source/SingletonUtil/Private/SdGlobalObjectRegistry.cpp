@@ -0,0 +1,121 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdGlobalObjectRegistry.h"
+
+
+void FSdGlobalObjectRegistry::Register(const FSdGlobalObjectHashKey& InHashKey, UObject* InObject)
+{
+	// the soft key is built outside of any lock, it may resolve a path name
+	const FSdGlobalObjectSoftHashKey SoftHashKey = FSdGlobalObjectSoftHashKey(InHashKey);
+	checkSlow(GetShardIndex(SoftHashKey) == GetShardIndex(InHashKey));
+
+	// both keys live in the same shard, readers never see the object without its class path or the other way around
+	FShard&			Shard = GetShard(InHashKey);
+	FWriteScopeLock WriteLock(Shard.Lock);
+	Shard.RegisteredObjects.Add(InHashKey, InObject);
+	Shard.RegisteredClassPaths.Add(SoftHashKey);
+}
+
+UObject* FSdGlobalObjectRegistry::Find(const FSdGlobalObjectHashKey& InHashKey) const
+{
+	const FShard& Shard = GetShard(InHashKey);
+	FReadScopeLock ReadLock(Shard.Lock);
+	const TObjectPtr<UObject>* FoundObject = Shard.RegisteredObjects.Find(InHashKey);
+	(FoundObject ? Shard.NumHits : Shard.NumMisses).fetch_add(1, std::memory_order_relaxed);
+	return FoundObject ? FoundObject->Get() : nullptr;
+}
+
+bool FSdGlobalObjectRegistry::Contains(const FSdGlobalObjectHashKey& InHashKey) const
+{
+	const FShard& Shard = GetShard(InHashKey);
+	FReadScopeLock ReadLock(Shard.Lock);
+	const bool bContains = Shard.RegisteredObjects.Contains(InHashKey);
+	(bContains ? Shard.NumHits : Shard.NumMisses).fetch_add(1, std::memory_order_relaxed);
+	return bContains;
+}
+
+bool FSdGlobalObjectRegistry::ContainsSoft(const FSdGlobalObjectSoftHashKey& InSoftHashKey) const
+{
+	const FShard& Shard = GetShard(InSoftHashKey);
+	FReadScopeLock ReadLock(Shard.Lock);
+	const bool bContains = Shard.RegisteredClassPaths.Contains(InSoftHashKey);
+	(bContains ? Shard.NumHits : Shard.NumMisses).fetch_add(1, std::memory_order_relaxed);
+	return bContains;
+}
+
+void FSdGlobalObjectRegistry::Empty()
+{
+	for (FShard& Shard : Shards)
+	{
+		FWriteScopeLock WriteLock(Shard.Lock);
+		Shard.RegisteredObjects.Empty();
+		Shard.RegisteredClassPaths.Empty();
+	}
+}
+
+int32 FSdGlobalObjectRegistry::Num() const
+{
+	int32 OutNum = 0;
+	for (const FShard& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		OutNum += Shard.RegisteredObjects.Num();
+	}
+	return OutNum;
+}
+
+void FSdGlobalObjectRegistry::ForEach(TFunctionRef<void(const FSdGlobalObjectHashKey&, UObject*)> Visitor) const
+{
+	for (const FShard& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		for (const auto& MapItx : Shard.RegisteredObjects)
+		{
+			Visitor(MapItx.Key, MapItx.Value);
+		}
+	}
+}
+
+void FSdGlobalObjectRegistry::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	for (FShard& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		for (auto& MapItx : Shard.RegisteredObjects)
+		{
+			// keys are immutable inside the map, the class is kept alive through a copy of the pointer
+			UClass* KeyClass = MapItx.Key.ObjectClass.Get();
+			Collector.AddReferencedObject(KeyClass);
+			Collector.AddReferencedObject(MapItx.Value);
+		}
+	}
+}
+
+FSdGlobalObjectRegistry::FStats FSdGlobalObjectRegistry::GetStats() const
+{
+	FStats OutStats;
+	for (const FShard& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		OutStats.NumEntries += Shard.RegisteredObjects.Num();
+		OutStats.AllocatedBytes += Shard.RegisteredObjects.GetAllocatedSize() + Shard.RegisteredClassPaths.GetAllocatedSize();
+		for (const auto& MapItx : Shard.RegisteredObjects)
+		{
+			if (!IsValid(MapItx.Value))
+			{
+				OutStats.NumStaleEntries++;
+			}
+		}
+		OutStats.Hits += Shard.NumHits.load(std::memory_order_relaxed);
+		OutStats.Misses += Shard.NumMisses.load(std::memory_order_relaxed);
+	}
+	return OutStats;
+}
+
+TMap<FSdGlobalObjectHashKey, UObject*> FSdGlobalObjectRegistry::GetRegisteredObjects() const
+{
+	TMap<FSdGlobalObjectHashKey, UObject*> OutRegisteredObjects;
+	ForEach([&OutRegisteredObjects](const FSdGlobalObjectHashKey& HashKey, UObject* Object) { OutRegisteredObjects.Add(HashKey, Object); });
+	return OutRegisteredObjects;
+}
@@ -0,0 +1,215 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdInterfaceInstanceIndex.h"
+#include "SdSingletonClassMetadata.h"
+
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Misc/ScopeLock.h"
+#include "UObject/UObjectHash.h"
+
+
+FSdInterfaceInstanceIndex::~FSdInterfaceInstanceIndex()
+{
+	Deinitialize();
+}
+
+void FSdInterfaceInstanceIndex::Initialize(const UWorld* InWorld)
+{
+	World = InWorld;
+}
+
+void FSdInterfaceInstanceIndex::Deinitialize()
+{
+	if (bListening)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		bListening = false;
+	}
+	Reset();
+	World = nullptr;
+}
+
+void FSdInterfaceInstanceIndex::Reset()
+{
+	InterfaceInstances.Empty();
+	{
+		FWriteScopeLock ScopeLock(ClassInterfacesLock);
+		ClassInterfaces.Empty();
+	}
+	FScopeLock ScopeLock(&CreatedObjectsCritical);
+	CreatedObjectIndices.Empty();
+}
+
+UObject* FSdInterfaceInstanceIndex::FindFirstInstance(const UClass* InInterfaceClass, TFunctionRef<bool(UObject*)> Filter)
+{
+	check(IsInGameThread());
+
+	// implementing classes were listed when the interface was indexed, a class loaded since could be missing
+	const uint64 CurrentVersion = GetRegisteredClassesVersionNumber();
+	if (CurrentVersion != RegisteredClassesVersion)
+	{
+		Reset();
+		RegisteredClassesVersion = CurrentVersion;
+	}
+	FlushCreatedObjects();
+
+	TMap<int32, FWeakObjectPtr>* Instances = InterfaceInstances.Find(InInterfaceClass);
+	if (!Instances)
+	{
+		Instances = &IndexInterface(InInterfaceClass);
+	}
+
+	UObject* FoundObject = nullptr;
+	int32	 FoundObjectIndex = MAX_int32;
+	for (auto MapItx = Instances->CreateIterator(); MapItx; ++MapItx)
+	{
+		UObject* Object = MapItx.Value().Get();
+		if (!Object)
+		{
+			MapItx.RemoveCurrent();
+			continue;
+		}
+		if (MapItx.Key() < FoundObjectIndex && Filter(Object))
+		{
+			FoundObject = Object;
+			FoundObjectIndex = MapItx.Key();
+		}
+	}
+	return FoundObject;
+}
+
+TMap<int32, FWeakObjectPtr>& FSdInterfaceInstanceIndex::IndexInterface(const UClass* InInterfaceClass)
+{
+	const TArray<const UClass*>& ImplementingClasses = FSdSingletonClassMetadata::Get().GetInterfaceImplementingClasses(InInterfaceClass);
+
+	// classes are registered with the listener before the scan, so an object created meanwhile is seen by one or the other
+	{
+		FWriteScopeLock ScopeLock(ClassInterfacesLock);
+		for (const UClass* ImplementingClass : ImplementingClasses)
+		{
+			ClassInterfaces.FindOrAdd(ImplementingClass).AddUnique(InInterfaceClass);
+		}
+	}
+	if (!bListening)
+	{
+		GUObjectArray.AddUObjectCreateListener(this);
+		bListening = true;
+	}
+
+	TMap<int32, FWeakObjectPtr>& Instances = InterfaceInstances.Add(InInterfaceClass);
+	ForEachObjectOfClasses(ImplementingClasses, [this, &Instances](UObject* Object)
+		{
+			if (IsInWorldScope(Object, World))
+			{
+				Instances.Add(GUObjectArray.ObjectToIndex(Object), FWeakObjectPtr(Object));
+			}
+		},
+		RF_NoFlags);
+	return Instances;
+}
+
+void FSdInterfaceInstanceIndex::FlushCreatedObjects()
+{
+	TArray<int32> ObjectIndices;
+	{
+		FScopeLock ScopeLock(&CreatedObjectsCritical);
+		ObjectIndices = MoveTemp(CreatedObjectIndices);
+		CreatedObjectIndices.Reset();
+	}
+
+	// an index may have been recycled since, the object found there is only kept if its class is indexed as well
+	for (const int32 ObjectIndex : ObjectIndices)
+	{
+		const FUObjectItem* ObjectItem = GUObjectArray.IndexToObject(ObjectIndex);
+		if (ObjectItem && ObjectItem->Object)
+		{
+			AddIfInScope(static_cast<UObject*>(ObjectItem->Object));
+		}
+	}
+}
+
+void FSdInterfaceInstanceIndex::AddIfInScope(UObject* InObject)
+{
+	const TArray<const UClass*, TInlineAllocator<2>>* Interfaces = ClassInterfaces.Find(InObject->GetClass());
+	if (!Interfaces || !IsInWorldScope(InObject, World))
+	{
+		return;
+	}
+
+	const int32 ObjectIndex = GUObjectArray.ObjectToIndex(InObject);
+	for (const UClass* InterfaceClass : *Interfaces)
+	{
+		if (TMap<int32, FWeakObjectPtr>* Instances = InterfaceInstances.Find(InterfaceClass))
+		{
+			Instances->Add(ObjectIndex, FWeakObjectPtr(InObject));
+		}
+	}
+}
+
+void FSdInterfaceInstanceIndex::AddLevelObjects(const ULevel* InLevel)
+{
+	if (!InLevel || InterfaceInstances.Num() == 0)
+	{
+		return;
+	}
+
+	FlushCreatedObjects();
+	ForEachObjectWithOuter(InLevel, [this](UObject* Object) { AddIfInScope(Object); }, true);
+}
+
+bool FSdInterfaceInstanceIndex::IsInWorldScope(const UObject* Object, const UWorld* InWorld)
+{
+	if (const ULevel* OuterLevel = Object->GetTypedOuter<ULevel>())
+	{
+		const UWorld* OwningWorld = OuterLevel->OwningWorld ? OuterLevel->OwningWorld.Get() : Object->GetWorld();
+		return OwningWorld == InWorld;
+	}
+	if (Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+	{
+		return true;
+	}
+	const UWorld* ObjectWorld = Object->GetWorld();
+	return !ObjectWorld || ObjectWorld == InWorld;
+}
+
+void FSdInterfaceInstanceIndex::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// may run on the async loading thread or any worker, the object is only classified on the game thread
+	{
+		FReadScopeLock ScopeLock(ClassInterfacesLock);
+		if (!ClassInterfaces.Contains(Object->GetClass()))
+		{
+			return;
+		}
+	}
+	FScopeLock ScopeLock(&CreatedObjectsCritical);
+	CreatedObjectIndices.Add(Index);
+}
+
+void FSdInterfaceInstanceIndex::OnUObjectArrayShutdown()
+{
+	GUObjectArray.RemoveUObjectCreateListener(this);
+	bListening = false;
+}
+
+SIZE_T FSdInterfaceInstanceIndex::GetAllocatedSize() const
+{
+	SIZE_T OutBytes = InterfaceInstances.GetAllocatedSize();
+	{
+		FScopeLock ScopeLock(&CreatedObjectsCritical);
+		OutBytes += CreatedObjectIndices.GetAllocatedSize();
+	}
+	for (const auto& MapItx : InterfaceInstances)
+	{
+		OutBytes += MapItx.Value.GetAllocatedSize();
+	}
+	FReadScopeLock ScopeLock(ClassInterfacesLock);
+	OutBytes += ClassInterfaces.GetAllocatedSize();
+	for (const auto& MapItx : ClassInterfaces)
+	{
+		OutBytes += MapItx.Value.GetAllocatedSize();
+	}
+	return OutBytes;
+}
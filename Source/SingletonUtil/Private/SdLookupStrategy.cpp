@@ -0,0 +1,174 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdLookupStrategy.h"
+
+#include "HAL/IConsoleManager.h"
+
+
+static TAutoConsoleVariable<int32> CVarSdLookupForceStrategy(
+	TEXT("SingletonUtil.Lookup.ForceStrategy"),
+	0,
+	TEXT("Forces how singleton cache misses are resolved, where the lookup supports it.\n")
+	TEXT(" 0: Auto, cheapest observed strategy per key (default)\n")
+	TEXT(" 1: Index\n")
+	TEXT(" 2: WorldActorScan\n")
+	TEXT(" 3: ClassHashScan\n")
+	TEXT(" 4: ObjectArrayScan"));
+
+static TAutoConsoleVariable<bool> CVarSdLookupDisableCache(
+	TEXT("SingletonUtil.Lookup.DisableCache"),
+	false,
+	TEXT("Bypasses the singleton caches and the actor resolution index, every lookup is resolved by a strategy."));
+
+static TAutoConsoleVariable<int32> CVarSdLookupExploreInterval(
+	TEXT("SingletonUtil.Lookup.ExploreInterval"),
+	64,
+	TEXT("Every this many misses of a key, its least measured strategy is measured again. 0 measures each strategy only once."));
+
+static TAutoConsoleVariable<float> CVarSdLookupExploreBudgetMs(
+	TEXT("SingletonUtil.Lookup.ExploreBudgetMs"),
+	0.f,
+	TEXT("Milliseconds of singleton scans per frame. A strategy other than the cheapest known one is only tried when its expected cost fits in what is left of the frame's budget. Lookups still scan with the cheapest known strategy. 0 is unlimited."));
+
+namespace SdLookupStrategy
+{
+	constexpr float CostSmoothing = 0.25f;
+} // namespace SdLookupStrategy
+
+ESdLookupStrategy FSdLookupStrategySelector::GetForcedStrategy()
+{
+	const int32 ForcedStrategy = CVarSdLookupForceStrategy.GetValueOnGameThread();
+	return ForcedStrategy > 0 && ForcedStrategy < int32(ESdLookupStrategy::MAX) ? ESdLookupStrategy(ForcedStrategy) : ESdLookupStrategy::Auto;
+}
+
+bool FSdLookupStrategySelector::IsCacheDisabled()
+{
+	return CVarSdLookupDisableCache.GetValueOnGameThread();
+}
+
+ESdLookupStrategy FSdLookupStrategySelector::SelectStrategy(const UClass* InClass, ESdLookupKind InKind, TConstArrayView<ESdLookupStrategy> InCandidates)
+{
+	check(InCandidates.Num() > 0);
+
+	const ESdLookupStrategy ForcedStrategy = GetForcedStrategy();
+	if (ForcedStrategy != ESdLookupStrategy::Auto && InCandidates.Contains(ForcedStrategy))
+	{
+		return ForcedStrategy;
+	}
+	if (InCandidates.Num() == 1)
+	{
+		return InCandidates[0];
+	}
+
+	FKeyCosts& Costs = KeyCosts.FindOrAdd(FCostKey(TObjectKey<UClass>(InClass), InKind));
+	Costs.NumSelections++;
+
+	ESdLookupStrategy CheapestStrategy = InCandidates[0];
+	float			  CheapestMilliseconds = TNumericLimits<float>::Max();
+	ESdLookupStrategy LeastSampledStrategy = InCandidates[0];
+	uint32			  LeastSamples = MAX_uint32;
+	int32			  UnmeasuredIndex = INDEX_NONE;
+	for (int32 Index = 0; Index < InCandidates.Num(); ++Index)
+	{
+		const FStrategyCost& Cost = Costs.Costs[uint8(InCandidates[Index])];
+		if (Cost.Samples == 0)
+		{
+			UnmeasuredIndex = UnmeasuredIndex == INDEX_NONE ? Index : UnmeasuredIndex;
+			continue;
+		}
+		if (Cost.AverageMilliseconds < CheapestMilliseconds)
+		{
+			CheapestStrategy = InCandidates[Index];
+			CheapestMilliseconds = Cost.AverageMilliseconds;
+		}
+		if (Cost.Samples < LeastSamples)
+		{
+			LeastSampledStrategy = InCandidates[Index];
+			LeastSamples = Cost.Samples;
+		}
+	}
+	if (CheapestMilliseconds == TNumericLimits<float>::Max())
+	{
+		// nothing measured yet, the preferred strategy has to run anyway
+		return InCandidates[0];
+	}
+
+	// a strategy is only explored when its expected cost fits in what is left of the frame's budget, an unmeasured one
+	// is expected to cost what the cheapest known one does
+	const float RemainingMilliseconds = GetRemainingExploreBudget();
+	if (UnmeasuredIndex != INDEX_NONE && CheapestMilliseconds <= RemainingMilliseconds)
+	{
+		return InCandidates[UnmeasuredIndex];
+	}
+
+	// costs change as the world fills up, so the others are measured again now and then
+	const int32 ExploreInterval = CVarSdLookupExploreInterval.GetValueOnGameThread();
+	if (ExploreInterval > 0 && Costs.NumSelections % uint32(ExploreInterval) == 0 && Costs.Costs[uint8(LeastSampledStrategy)].AverageMilliseconds <= RemainingMilliseconds)
+	{
+		return LeastSampledStrategy;
+	}
+	return CheapestStrategy;
+}
+
+void FSdLookupStrategySelector::RecordCost(const UClass* InClass, ESdLookupKind InKind, ESdLookupStrategy InStrategy, float InMilliseconds)
+{
+	GetRemainingExploreBudget();
+	FrameScanMilliseconds += InMilliseconds;
+
+	FStrategyCost& Cost = KeyCosts.FindOrAdd(FCostKey(TObjectKey<UClass>(InClass), InKind)).Costs[uint8(InStrategy)];
+	Cost.AverageMilliseconds = Cost.Samples == 0 ? InMilliseconds : FMath::Lerp(Cost.AverageMilliseconds, InMilliseconds, SdLookupStrategy::CostSmoothing);
+	Cost.Samples++;
+}
+
+float FSdLookupStrategySelector::GetAverageCost(const UClass* InClass, ESdLookupKind InKind, ESdLookupStrategy InStrategy) const
+{
+	const FKeyCosts* Costs = KeyCosts.Find(FCostKey(TObjectKey<UClass>(InClass), InKind));
+	if (!Costs || Costs->Costs[uint8(InStrategy)].Samples == 0)
+	{
+		return -1.f;
+	}
+	return Costs->Costs[uint8(InStrategy)].AverageMilliseconds;
+}
+
+void FSdLookupStrategySelector::ForEachKeyCost(TFunctionRef<void(const UClass* InClass, ESdLookupKind InKind, ESdLookupStrategy InStrategy, float InAverageMilliseconds, uint32 InSamples)> Visitor) const
+{
+	for (const auto& MapItx : KeyCosts)
+	{
+		const UClass* KeyClass = MapItx.Key.Key.ResolveObjectPtr();
+		if (!KeyClass)
+		{
+			continue;
+		}
+		for (uint8 StrategyIndex = 0; StrategyIndex < uint8(ESdLookupStrategy::MAX); ++StrategyIndex)
+		{
+			const FStrategyCost& Cost = MapItx.Value.Costs[StrategyIndex];
+			if (Cost.Samples > 0)
+			{
+				Visitor(KeyClass, MapItx.Key.Value, ESdLookupStrategy(StrategyIndex), Cost.AverageMilliseconds, Cost.Samples);
+			}
+		}
+	}
+}
+
+float FSdLookupStrategySelector::GetRemainingExploreBudget()
+{
+	if (BudgetFrame != GFrameCounter)
+	{
+		BudgetFrame = GFrameCounter;
+		FrameScanMilliseconds = 0.f;
+	}
+
+	const float ExploreBudgetMilliseconds = CVarSdLookupExploreBudgetMs.GetValueOnGameThread();
+	return ExploreBudgetMilliseconds > 0.f ? ExploreBudgetMilliseconds - FrameScanMilliseconds : TNumericLimits<float>::Max();
+}
+
+void FSdLookupStrategySelector::Reset()
+{
+	KeyCosts.Empty();
+}
+
+SIZE_T FSdLookupStrategySelector::GetAllocatedSize() const
+{
+	return KeyCosts.GetAllocatedSize();
+}
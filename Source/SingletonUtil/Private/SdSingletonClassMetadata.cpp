@@ -0,0 +1,128 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdSingletonClassMetadata.h"
+
+#include "UObject/Class.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+
+FSdSingletonClassMetadata& FSdSingletonClassMetadata::Get()
+{
+	static FSdSingletonClassMetadata Instance;
+	return Instance;
+}
+
+void FSdSingletonClassMetadata::RefreshIfClassesChanged()
+{
+	check(IsInGameThread());
+
+	// classes only ever load or unload in bulk (startup, map loads, blueprint compiles), so a full refresh is cheap overall
+	const uint64 CurrentVersion = GetRegisteredClassesVersionNumber();
+	if (CurrentVersion != RegisteredClassesVersion)
+	{
+		DerivedClasses.Empty();
+		InterfaceImplementers.Empty();
+		ClassDepths.Empty();
+		RegisteredClassesVersion = CurrentVersion;
+	}
+}
+
+const TArray<UClass*>& FSdSingletonClassMetadata::GetDerivedClasses(const UClass* InClass, bool* OutbCacheHit)
+{
+	RefreshIfClassesChanged();
+
+	if (TArray<UClass*>* CachedClasses = DerivedClasses.Find(InClass))
+	{
+		if (OutbCacheHit)
+		{
+			*OutbCacheHit = true;
+		}
+		return *CachedClasses;
+	}
+	if (OutbCacheHit)
+	{
+		*OutbCacheHit = false;
+	}
+
+	TArray<UClass*>& ChildClasses = DerivedClasses.Add(InClass);
+	::GetDerivedClasses(InClass, ChildClasses, false);
+	return ChildClasses;
+}
+
+void FSdSingletonClassMetadata::AddDerivedClasses(const UClass* InClass, TConstArrayView<UClass*> InDerivedClasses)
+{
+	RefreshIfClassesChanged();
+
+	TArray<UClass*>& ChildClasses = DerivedClasses.FindOrAdd(InClass);
+	for (UClass* DerivedClass : InDerivedClasses)
+	{
+		ChildClasses.AddUnique(DerivedClass);
+	}
+}
+
+const TArray<const UClass*>& FSdSingletonClassMetadata::GetInterfaceImplementingClasses(const UClass* InInterfaceClass)
+{
+	RefreshIfClassesChanged();
+
+	if (TArray<const UClass*>* CachedClasses = InterfaceImplementers.Find(InInterfaceClass))
+	{
+		return *CachedClasses;
+	}
+
+	TArray<const UClass*>& ImplementingClasses = InterfaceImplementers.Add(InInterfaceClass);
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (!It->HasAnyClassFlags(CLASS_Interface | CLASS_NewerVersionExists) && It->ImplementsInterface(InInterfaceClass))
+		{
+			ImplementingClasses.Add(*It);
+		}
+	}
+	return ImplementingClasses;
+}
+
+int32 FSdSingletonClassMetadata::GetClassDepth(const UClass* InClass)
+{
+	RefreshIfClassesChanged();
+
+	if (const int32* CachedDepth = ClassDepths.Find(InClass))
+	{
+		return *CachedDepth;
+	}
+
+	int32 Depth = 0;
+	for (const UClass* SuperClass = InClass->GetSuperClass(); SuperClass; SuperClass = SuperClass->GetSuperClass())
+	{
+		Depth++;
+	}
+	ClassDepths.Add(InClass, Depth);
+	return Depth;
+}
+
+int32 FSdSingletonClassMetadata::GetNumEntries() const
+{
+	return DerivedClasses.Num() + InterfaceImplementers.Num() + ClassDepths.Num();
+}
+
+void FSdSingletonClassMetadata::ForEachDerivedClassList(TFunctionRef<void(const UClass*, const TArray<UClass*>&)> Visitor) const
+{
+	for (const auto& MapItx : DerivedClasses)
+	{
+		Visitor(MapItx.Key, MapItx.Value);
+	}
+}
+
+SIZE_T FSdSingletonClassMetadata::GetAllocatedSize() const
+{
+	SIZE_T OutBytes = DerivedClasses.GetAllocatedSize() + InterfaceImplementers.GetAllocatedSize() + ClassDepths.GetAllocatedSize();
+	for (const auto& MapItx : DerivedClasses)
+	{
+		OutBytes += MapItx.Value.GetAllocatedSize();
+	}
+	for (const auto& MapItx : InterfaceImplementers)
+	{
+		OutBytes += MapItx.Value.GetAllocatedSize();
+	}
+	return OutBytes;
+}
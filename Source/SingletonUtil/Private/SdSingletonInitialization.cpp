@@ -0,0 +1,309 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdSingletonInitialization.h"
+#include "SdSingletonSubsystem.h"
+
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "Tasks/Task.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSdSingletonInitialization, Log, All);
+
+
+namespace SdSingletonInitialization
+{
+	struct FInitNode
+	{
+		UClass*						Class = nullptr;
+		TArray<UClass*>				DependencyClasses;
+		TArray<int32>				Dependencies;
+		UObject*					Singleton = nullptr;
+		ISdSingletonInitializable*	Initializable = nullptr;
+		UE::Tasks::FTask			PrepareTask;
+		double						PrepareSeconds = 0.0;
+		int32						CriticalPathParent = INDEX_NONE;
+	};
+
+	static bool IsSingletonClass(const UClass* InClass)
+	{
+		return InClass->IsChildOf(AActor::StaticClass()) || InClass->IsChildOf(UActorComponent::StaticClass());
+	}
+
+	static float ToMilliseconds(double Seconds)
+	{
+		return float(Seconds * 1000.0);
+	}
+} // namespace SdSingletonInitialization
+
+
+void USdSingletonSubsystem::AddSingletonDependency(TSubclassOf<UObject> InSingletonClass, TSubclassOf<UObject> InDependencyClass)
+{
+	if (!IsValid(InSingletonClass) || !IsValid(InDependencyClass) || InSingletonClass == InDependencyClass)
+	{
+		return;
+	}
+	SingletonDependencies.FindOrAdd(InSingletonClass).Dependencies.AddUnique(InDependencyClass);
+}
+
+FSdSingletonInitReport USdSingletonSubsystem::InitializeSingletons(const TArray<TSubclassOf<UObject>>& InSingletonClasses)
+{
+	using namespace SdSingletonInitialization;
+
+	FSdSingletonInitReport Report;
+	const double		   StartSeconds = FPlatformTime::Seconds();
+
+	// singletons destroyed without an actor destroyed event, such as components, are forgotten here
+	for (auto It = InitializedSingletons.CreateIterator(); It; ++It)
+	{
+		if (!It->ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// gather the requested classes and everything they depend on
+	TArray<FInitNode>		  Nodes;
+	TMap<const UClass*, int32> NodeIndices;
+	TArray<UClass*>			  PendingClasses;
+	for (int32 ClassIndex = InSingletonClasses.Num() - 1; ClassIndex >= 0; --ClassIndex)
+	{
+		PendingClasses.Add(InSingletonClasses[ClassIndex]);
+	}
+
+	while (PendingClasses.Num() > 0)
+	{
+		UClass* SingletonClass = PendingClasses.Pop();
+		if (!IsValid(SingletonClass) || NodeIndices.Contains(SingletonClass))
+		{
+			continue;
+		}
+		if (!IsSingletonClass(SingletonClass))
+		{
+			UE_LOG(LogSdSingletonInitialization, Warning, TEXT("InitializeSingletons: %s is not an actor or component class, skipped"), *SingletonClass->GetName());
+			continue;
+		}
+
+		NodeIndices.Add(SingletonClass, Nodes.Num());
+		FInitNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.Class = SingletonClass;
+
+		if (const FSdSingletonDependencyList* DependencyList = SingletonDependencies.Find(SingletonClass))
+		{
+			for (const TSubclassOf<UObject>& DependencyClass : DependencyList->Dependencies)
+			{
+				Node.DependencyClasses.AddUnique(DependencyClass);
+			}
+		}
+		if (const ISdSingletonInitializable* DefaultInitializable = Cast<ISdSingletonInitializable>(SingletonClass->GetDefaultObject()))
+		{
+			TArray<UClass*> DeclaredDependencies;
+			DefaultInitializable->GetSingletonDependencies(DeclaredDependencies);
+			for (UClass* DependencyClass : DeclaredDependencies)
+			{
+				Node.DependencyClasses.AddUnique(DependencyClass);
+			}
+		}
+
+		for (int32 DependencyIndex = Node.DependencyClasses.Num() - 1; DependencyIndex >= 0; --DependencyIndex)
+		{
+			PendingClasses.Add(Node.DependencyClasses[DependencyIndex]);
+		}
+	}
+
+	// topological order, independent singletons keep the order they were requested in
+	TArray<int32> NumPendingDependencies;
+	TArray<TArray<int32>> Dependents;
+	NumPendingDependencies.SetNumZeroed(Nodes.Num());
+	Dependents.SetNum(Nodes.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		for (UClass* DependencyClass : Nodes[NodeIndex].DependencyClasses)
+		{
+			const int32* DependencyIndex = NodeIndices.Find(DependencyClass);
+			if (DependencyIndex && *DependencyIndex != NodeIndex)
+			{
+				Dependents[*DependencyIndex].Add(NodeIndex);
+				NumPendingDependencies[NodeIndex]++;
+			}
+		}
+	}
+
+	TArray<int32> InitOrder;
+	InitOrder.Reserve(Nodes.Num());
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		if (NumPendingDependencies[NodeIndex] == 0)
+		{
+			InitOrder.Add(NodeIndex);
+		}
+	}
+	for (int32 OrderIndex = 0; OrderIndex < InitOrder.Num(); ++OrderIndex)
+	{
+		for (int32 DependentIndex : Dependents[InitOrder[OrderIndex]])
+		{
+			if (--NumPendingDependencies[DependentIndex] == 0)
+			{
+				InitOrder.Add(DependentIndex);
+			}
+		}
+	}
+
+	// whatever is left is in or behind a cycle, initialized last in gathering order
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		if (NumPendingDependencies[NodeIndex] > 0)
+		{
+			InitOrder.Add(NodeIndex);
+			Report.CyclicClasses.Add(Nodes[NodeIndex].Class);
+			UE_LOG(LogSdSingletonInitialization, Error, TEXT("InitializeSingletons: %s is in or depends on a dependency cycle, its cyclic dependencies are ignored"), *Nodes[NodeIndex].Class->GetName());
+		}
+	}
+
+	// only keep dependencies initialized earlier, which removes the cycles
+	TArray<int32> OrderPositions;
+	OrderPositions.SetNum(Nodes.Num());
+	for (int32 OrderIndex = 0; OrderIndex < InitOrder.Num(); ++OrderIndex)
+	{
+		OrderPositions[InitOrder[OrderIndex]] = OrderIndex;
+	}
+	for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		for (UClass* DependencyClass : Nodes[NodeIndex].DependencyClasses)
+		{
+			const int32* DependencyIndex = NodeIndices.Find(DependencyClass);
+			if (DependencyIndex && OrderPositions[*DependencyIndex] < OrderPositions[NodeIndex])
+			{
+				Nodes[NodeIndex].Dependencies.Add(*DependencyIndex);
+			}
+		}
+	}
+
+	// spawning has to happen on the game thread, dependencies first so their BeginPlay runs first
+	Report.Steps.SetNum(InitOrder.Num());
+	for (int32 OrderIndex = 0; OrderIndex < InitOrder.Num(); ++OrderIndex)
+	{
+		FInitNode&			  Node = Nodes[InitOrder[OrderIndex]];
+		FSdSingletonInitStep& Step = Report.Steps[OrderIndex];
+		Step.SingletonClass = Node.Class;
+
+		const double SpawnStartSeconds = FPlatformTime::Seconds();
+		if (Node.Class->IsChildOf(AActor::StaticClass()))
+		{
+			Node.Singleton = K2_GetSingletonActor(Node.Class, true, false);
+		}
+		else
+		{
+			Node.Singleton = K2_GetSingletonComponent(Node.Class, true);
+		}
+		Step.SpawnMilliseconds = ToMilliseconds(FPlatformTime::Seconds() - SpawnStartSeconds);
+		Step.Singleton = Node.Singleton;
+
+		if (IsValid(Node.Singleton) && !InitializedSingletons.Contains(FObjectKey(Node.Singleton)))
+		{
+			Node.Initializable = Cast<ISdSingletonInitializable>(Node.Singleton);
+			Step.bInitialized = true;
+		}
+	}
+
+	// prepare work runs on workers as soon as the prepare work of the dependencies is done. Singletons without
+	// prepare work still forward their dependencies, so dependents never start before a transitive dependency
+	for (int32 NodeIndex : InitOrder)
+	{
+		FInitNode& Node = Nodes[NodeIndex];
+
+		TArray<UE::Tasks::FTask> Prerequisites;
+		for (int32 DependencyIndex : Node.Dependencies)
+		{
+			if (Nodes[DependencyIndex].PrepareTask.IsValid())
+			{
+				Prerequisites.Add(Nodes[DependencyIndex].PrepareTask);
+			}
+		}
+
+		if (Node.Initializable)
+		{
+			Node.PrepareTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Initializable = Node.Initializable, PrepareSeconds = &Node.PrepareSeconds]()
+				{
+					const double PrepareStartSeconds = FPlatformTime::Seconds();
+					Initializable->PrepareSingleton();
+					*PrepareSeconds = FPlatformTime::Seconds() - PrepareStartSeconds;
+				},
+				Prerequisites);
+		}
+		else if (Prerequisites.Num() > 0)
+		{
+			Node.PrepareTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, []() {}, Prerequisites);
+		}
+	}
+
+	// finalize in dependency order, each one only waits for its own prepare work
+	for (int32 OrderIndex = 0; OrderIndex < InitOrder.Num(); ++OrderIndex)
+	{
+		const int32			  NodeIndex = InitOrder[OrderIndex];
+		FInitNode&			  Node = Nodes[NodeIndex];
+		FSdSingletonInitStep& Step = Report.Steps[OrderIndex];
+
+		if (Node.PrepareTask.IsValid())
+		{
+			Node.PrepareTask.Wait();
+		}
+
+		if (Step.bInitialized)
+		{
+			const double FinalizeStartSeconds = FPlatformTime::Seconds();
+			if (Node.Initializable && IsValid(Node.Singleton))
+			{
+				Node.Initializable->FinalizeSingleton();
+			}
+			Step.FinalizeMilliseconds = ToMilliseconds(FPlatformTime::Seconds() - FinalizeStartSeconds);
+			Step.PrepareMilliseconds = ToMilliseconds(Node.PrepareSeconds);
+			InitializedSingletons.Add(FObjectKey(Node.Singleton));
+		}
+	}
+
+	// longest chain of dependent work over the dependency graph. Spawning is left out, every singleton is spawned
+	// serially before any prepare work starts, so it never shortens or lengthens a chain
+	TArray<float> CriticalPathMilliseconds;
+	CriticalPathMilliseconds.SetNumZeroed(Nodes.Num());
+	int32 CriticalPathEnd = INDEX_NONE;
+	for (int32 OrderIndex = 0; OrderIndex < InitOrder.Num(); ++OrderIndex)
+	{
+		const int32			  NodeIndex = InitOrder[OrderIndex];
+		FInitNode&			  Node = Nodes[NodeIndex];
+		FSdSingletonInitStep& Step = Report.Steps[OrderIndex];
+
+		float LongestDependencyPath = 0.f;
+		for (int32 DependencyIndex : Node.Dependencies)
+		{
+			if (Node.CriticalPathParent == INDEX_NONE || CriticalPathMilliseconds[DependencyIndex] > LongestDependencyPath)
+			{
+				LongestDependencyPath = CriticalPathMilliseconds[DependencyIndex];
+				Node.CriticalPathParent = DependencyIndex;
+			}
+		}
+		CriticalPathMilliseconds[NodeIndex] = LongestDependencyPath + Step.PrepareMilliseconds + Step.FinalizeMilliseconds;
+		Step.CriticalPathMilliseconds = CriticalPathMilliseconds[NodeIndex];
+
+		if (CriticalPathEnd == INDEX_NONE || Step.CriticalPathMilliseconds > Report.CriticalPathMilliseconds)
+		{
+			Report.CriticalPathMilliseconds = Step.CriticalPathMilliseconds;
+			CriticalPathEnd = NodeIndex;
+		}
+	}
+	for (int32 PathIndex = CriticalPathEnd; PathIndex != INDEX_NONE; PathIndex = Nodes[PathIndex].CriticalPathParent)
+	{
+		Report.CriticalPath.Insert(Nodes[PathIndex].Class, 0);
+	}
+
+	Report.TotalMilliseconds = ToMilliseconds(FPlatformTime::Seconds() - StartSeconds);
+
+	UE_LOG(LogSdSingletonInitialization, Log, TEXT("InitializeSingletons: %d singletons in %.2f ms, critical path %.2f ms through %d singletons"),
+		Report.Steps.Num(), Report.TotalMilliseconds, Report.CriticalPathMilliseconds, Report.CriticalPath.Num());
+	for (const TSubclassOf<UObject>& PathClass : Report.CriticalPath)
+	{
+		UE_LOG(LogSdSingletonInitialization, Log, TEXT("  %s"), *GetNameSafe(PathClass));
+	}
+
+	return Report;
+}
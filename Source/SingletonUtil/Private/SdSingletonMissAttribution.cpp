@@ -0,0 +1,296 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdSingletonMissAttribution.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/Crc.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/Script.h"
+#include "UObject/Stack.h"
+
+
+static TAutoConsoleVariable<bool> CVarSdAttributionEnable(
+	TEXT("SingletonUtil.Attribution.Enable"),
+	false,
+	TEXT("Attributes every singleton cache miss scan to its Blueprint or native call site, see SingletonUtil.Attribution.Report."));
+
+namespace SdSingletonMissAttribution
+{
+	// frames inside the plugin are skipped by name when its module range is unknown
+	static bool IsPluginFrame(const ANSICHAR* FunctionName)
+	{
+		return FCStringAnsi::Strstr(FunctionName, "SdSingleton") || FCStringAnsi::Strstr(FunctionName, "SingletonUtilBPLibrary");
+	}
+
+	static void InitStackWalking()
+	{
+		static bool bStackWalkingInitialized = false;
+		if (!bStackWalkingInitialized)
+		{
+			FPlatformStackWalk::InitStackWalking();
+			bStackWalkingInitialized = true;
+		}
+	}
+
+	static FString DescribeProgramCounter(uint64 ProgramCounter)
+	{
+		if (!ProgramCounter)
+		{
+			return TEXT("<unknown native caller>");
+		}
+		FProgramCounterSymbolInfo SymbolInfo;
+		FPlatformStackWalk::ProgramCounterToSymbolInfo(ProgramCounter, SymbolInfo);
+		if (SymbolInfo.FunctionName[0] == '\0')
+		{
+			return FString::Printf(TEXT("0x%016llx"), ProgramCounter);
+		}
+		return FString::Printf(TEXT("%s [%s:%d]"), ANSI_TO_TCHAR(SymbolInfo.FunctionName), *FPaths::GetCleanFilename(ANSI_TO_TCHAR(SymbolInfo.Filename)), SymbolInfo.LineNumber);
+	}
+
+	// first symbolicated frame outside the plugin, frames without symbols cannot be told apart and are skipped
+	static FString FindNamedCallSite(const uint64* BackTrace, int32 NumFrames)
+	{
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames && BackTrace[FrameIndex]; ++FrameIndex)
+		{
+			FProgramCounterSymbolInfo SymbolInfo;
+			FPlatformStackWalk::ProgramCounterToSymbolInfo(BackTrace[FrameIndex], SymbolInfo);
+			if (SymbolInfo.FunctionName[0] != '\0' && !IsPluginFrame(SymbolInfo.FunctionName))
+			{
+				return DescribeProgramCounter(BackTrace[FrameIndex]);
+			}
+		}
+		return TEXT("<unresolved native caller, see the sample stack>");
+	}
+
+	static FString DescribeBackTrace(const uint64* BackTrace, int32 NumFrames)
+	{
+		FString OutStack;
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames && BackTrace[FrameIndex]; ++FrameIndex)
+		{
+			if (!OutStack.IsEmpty())
+			{
+				OutStack += TEXT(" <- ");
+			}
+			OutStack += DescribeProgramCounter(BackTrace[FrameIndex]);
+		}
+		return OutStack;
+	}
+} // namespace SdSingletonMissAttribution
+
+FSdSingletonMissAttribution& FSdSingletonMissAttribution::Get()
+{
+	static FSdSingletonMissAttribution Instance;
+	return Instance;
+}
+
+bool FSdSingletonMissAttribution::IsEnabled()
+{
+	return CVarSdAttributionEnable.GetValueOnGameThread();
+}
+
+void FSdSingletonMissAttribution::RecordScan(const UClass* InKey, float InScanMilliseconds)
+{
+	check(IsInGameThread());
+
+	FCallSiteKey CallSiteKey;
+	CallSiteKey.Key = InKey;
+
+	const FFrame* ScriptFrame = nullptr;
+#if DO_BLUEPRINT_GUARD
+	const TArrayView<const FFrame* const> ScriptStack = FBlueprintContextTracker::Get().GetCurrentScriptStack();
+	if (ScriptStack.Num() > 0 && ScriptStack.Last() && ScriptStack.Last()->Node)
+	{
+		ScriptFrame = ScriptStack.Last();
+		CallSiteKey.ScriptFunction = ScriptFrame->Node;
+		CallSiteKey.ScriptCodeOffset = ScriptFrame->Code ? int32(ScriptFrame->Code - ScriptFrame->Node->Script.GetData()) : INDEX_NONE;
+	}
+#endif
+
+	// only raw program counters are captured here, symbols are resolved when the report is built
+	uint64 BackTrace[MaxNativeFrames] = {};
+	if (!ScriptFrame)
+	{
+		InitPluginModuleRange();
+		FPlatformStackWalk::CaptureStackBackTrace(BackTrace, MaxNativeFrames);
+		if (PluginModuleEnd > PluginModuleBegin)
+		{
+			CallSiteKey.NativeCallSite = FindNativeCallSite(BackTrace);
+		}
+		else
+		{
+			CallSiteKey.NativeStackHash = FCrc::MemCrc32(BackTrace, sizeof(BackTrace));
+		}
+	}
+
+	FCallSiteStats* Stats = CallSites.Find(CallSiteKey);
+	if (!Stats)
+	{
+		Stats = &CallSites.Add(CallSiteKey);
+		Stats->KeyName = GetNameSafe(InKey);
+		if (ScriptFrame)
+		{
+			Stats->ScriptLocation = FString::Printf(TEXT("%s (%s) +%d"), *ScriptFrame->Node->GetPathName(), *GetNameSafe(ScriptFrame->Object), CallSiteKey.ScriptCodeOffset);
+		}
+		else
+		{
+			FMemory::Memcpy(Stats->SampleBackTrace, BackTrace, sizeof(BackTrace));
+		}
+	}
+	Stats->Scans++;
+	Stats->TotalMilliseconds += InScanMilliseconds;
+}
+
+uint64 FSdSingletonMissAttribution::FindNativeCallSite(const uint64* InBackTrace) const
+{
+	for (int32 FrameIndex = 0; FrameIndex < MaxNativeFrames && InBackTrace[FrameIndex]; ++FrameIndex)
+	{
+		const uint64 ProgramCounter = InBackTrace[FrameIndex];
+		if (ProgramCounter < PluginModuleBegin || ProgramCounter >= PluginModuleEnd)
+		{
+			return ProgramCounter;
+		}
+	}
+	return 0;
+}
+
+void FSdSingletonMissAttribution::InitPluginModuleRange()
+{
+	if (bPluginModuleRangeInitialized)
+	{
+		return;
+	}
+	bPluginModuleRangeInitialized = true;
+
+#if !IS_MONOLITHIC
+	// listed once when the first native scan is attributed, the module containing this function is the plugin's
+	SdSingletonMissAttribution::InitStackWalking();
+	const int32 NumModules = FPlatformStackWalk::GetProcessModuleCount();
+	if (NumModules <= 0)
+	{
+		return;
+	}
+
+	TArray<FStackWalkModuleInfo> Modules;
+	Modules.SetNumZeroed(NumModules);
+	Modules.SetNum(FPlatformStackWalk::GetProcessModuleSignatures(Modules.GetData(), NumModules));
+
+	const uint64 PluginAddress = uint64(reinterpret_cast<UPTRINT>(&FSdSingletonMissAttribution::Get));
+	for (const FStackWalkModuleInfo& Module : Modules)
+	{
+		if (PluginAddress >= Module.BaseOfImage && PluginAddress < Module.BaseOfImage + Module.ImageSize)
+		{
+			PluginModuleBegin = Module.BaseOfImage;
+			PluginModuleEnd = Module.BaseOfImage + Module.ImageSize;
+			break;
+		}
+	}
+#endif
+}
+
+TArray<FSdSingletonMissAttribution::FCallSiteReport> FSdSingletonMissAttribution::BuildReport() const
+{
+	SdSingletonMissAttribution::InitStackWalking();
+
+	// stacks recorded without the module range are merged here once their call site is known by name
+	TArray<FCallSiteReport>				 Report;
+	TMap<TPair<FString, FString>, int32> ReportIndices;
+	Report.Reserve(CallSites.Num());
+	for (const auto& CallSiteItx : CallSites)
+	{
+		FString CallSite;
+		if (!CallSiteItx.Value.ScriptLocation.IsEmpty())
+		{
+			CallSite = CallSiteItx.Value.ScriptLocation;
+		}
+		else if (CallSiteItx.Key.NativeStackHash != 0)
+		{
+			CallSite = SdSingletonMissAttribution::FindNamedCallSite(CallSiteItx.Value.SampleBackTrace, MaxNativeFrames);
+		}
+		else
+		{
+			CallSite = SdSingletonMissAttribution::DescribeProgramCounter(CallSiteItx.Key.NativeCallSite);
+		}
+
+		const TPair<FString, FString> ReportKey(CallSiteItx.Value.KeyName, CallSite);
+		if (const int32* ReportIndex = ReportIndices.Find(ReportKey))
+		{
+			Report[*ReportIndex].Scans += CallSiteItx.Value.Scans;
+			Report[*ReportIndex].TotalMilliseconds += CallSiteItx.Value.TotalMilliseconds;
+			continue;
+		}
+		ReportIndices.Add(ReportKey, Report.Num());
+
+		FCallSiteReport& CallSiteReport = Report.AddDefaulted_GetRef();
+		CallSiteReport.CallSite = MoveTemp(CallSite);
+		if (CallSiteItx.Value.ScriptLocation.IsEmpty())
+		{
+			CallSiteReport.SampleStack = SdSingletonMissAttribution::DescribeBackTrace(CallSiteItx.Value.SampleBackTrace, MaxNativeFrames);
+		}
+		CallSiteReport.KeyName = CallSiteItx.Value.KeyName;
+		CallSiteReport.Scans = CallSiteItx.Value.Scans;
+		CallSiteReport.TotalMilliseconds = CallSiteItx.Value.TotalMilliseconds;
+	}
+
+	Report.Sort([](const FCallSiteReport& A, const FCallSiteReport& B) { return A.TotalMilliseconds > B.TotalMilliseconds; });
+	return Report;
+}
+
+void FSdSingletonMissAttribution::Reset()
+{
+	CallSites.Empty();
+}
+
+static void SdSingletonAttributionReport(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	const bool	bWriteFile = Args.Contains(TEXT("file"));
+	int32		MaxCallSites = 20;
+	for (const FString& Arg : Args)
+	{
+		if (Arg.IsNumeric())
+		{
+			MaxCallSites = FMath::Max(FCString::Atoi(*Arg), 1);
+		}
+	}
+
+	const TArray<FSdSingletonMissAttribution::FCallSiteReport> Report = FSdSingletonMissAttribution::Get().BuildReport();
+	if (bWriteFile)
+	{
+		TArray<FString> Lines;
+		Lines.Reserve(Report.Num() + 1);
+		Lines.Add(TEXT("Rank,Scans,TotalMs,AverageMs,Key,CallSite,SampleStack"));
+		for (int32 Rank = 0; Rank < Report.Num(); ++Rank)
+		{
+			const FSdSingletonMissAttribution::FCallSiteReport& CallSite = Report[Rank];
+			Lines.Add(FString::Printf(TEXT("%d,%llu,%.3f,%.3f,%s,\"%s\",\"%s\""), Rank + 1, CallSite.Scans, CallSite.TotalMilliseconds, CallSite.TotalMilliseconds / double(CallSite.Scans), *CallSite.KeyName, *CallSite.CallSite.Replace(TEXT("\""), TEXT("\"\"")), *CallSite.SampleStack.Replace(TEXT("\""), TEXT("\"\""))));
+		}
+
+		const FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("SingletonUtil"), TEXT("Attribution"), FString::Printf(TEXT("MissHotspots-%s.csv"), *FDateTime::Now().ToString()));
+		if (FFileHelper::SaveStringArrayToFile(Lines, *ReportPath))
+		{
+			Ar.Logf(TEXT("SingletonUtil miss attribution written to %s"), *FPaths::ConvertRelativePathToFull(ReportPath));
+		}
+		return;
+	}
+
+	Ar.Logf(TEXT("SingletonUtil miss hotspots, %d call sites%s"), Report.Num(), FSdSingletonMissAttribution::IsEnabled() ? TEXT("") : TEXT(" (SingletonUtil.Attribution.Enable is off)"));
+	Ar.Logf(TEXT("  %4s %8s %10s %8s  %-32s %s"), TEXT("Rank"), TEXT("Scans"), TEXT("TotalMs"), TEXT("AvgMs"), TEXT("Key"), TEXT("CallSite"));
+	for (int32 Rank = 0; Rank < FMath::Min(Report.Num(), MaxCallSites); ++Rank)
+	{
+		const FSdSingletonMissAttribution::FCallSiteReport& CallSite = Report[Rank];
+		Ar.Logf(TEXT("  %4d %8llu %10.3f %8.3f  %-32s %s"), Rank + 1, CallSite.Scans, CallSite.TotalMilliseconds, CallSite.TotalMilliseconds / double(CallSite.Scans), *CallSite.KeyName, *CallSite.CallSite);
+	}
+}
+
+static FAutoConsoleCommandWithArgsAndOutputDevice SdSingletonAttributionReportCommand(
+	TEXT("SingletonUtil.Attribution.Report"),
+	TEXT("Prints the singleton cache miss call sites ranked by cumulative scan time. Args: [Count] [file], file writes every call site to Saved/SingletonUtil/Attribution as csv."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&SdSingletonAttributionReport));
+
+static FAutoConsoleCommand SdSingletonAttributionResetCommand(
+	TEXT("SingletonUtil.Attribution.Reset"),
+	TEXT("Forgets every attributed singleton cache miss."),
+	FConsoleCommandDelegate::CreateLambda([]() { FSdSingletonMissAttribution::Get().Reset(); }));
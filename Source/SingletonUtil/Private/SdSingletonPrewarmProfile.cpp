@@ -0,0 +1,186 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdSingletonPrewarmProfile.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+
+
+static TAutoConsoleVariable<bool> CVarSdPrewarmRecord(
+	TEXT("SingletonUtil.Prewarm.Record"),
+	false,
+	TEXT("Records which singleton keys each map requests, saved per map when its world is torn down or on SingletonUtil.Prewarm.Save."));
+
+static TAutoConsoleVariable<bool> CVarSdPrewarmEnable(
+	TEXT("SingletonUtil.Prewarm.Enable"),
+	true,
+	TEXT("Resolves the keys of the map's prewarm profile when its world begins play, before actors begin play."));
+
+static TAutoConsoleVariable<float> CVarSdPrewarmBudgetMs(
+	TEXT("SingletonUtil.Prewarm.BudgetMs"),
+	2.f,
+	TEXT("Milliseconds spent resolving prewarm keys at begin play and then on each following frame until every key is resolved."));
+
+namespace SdSingletonPrewarm
+{
+	static const TCHAR* FileHeader = TEXT("SdPrewarm 1");
+
+	static const TCHAR KindChars[] = { TEXT('A'), TEXT('C'), TEXT('I') };
+} // namespace SdSingletonPrewarm
+
+bool FSdSingletonPrewarmProfile::IsRecordingEnabled()
+{
+	return CVarSdPrewarmRecord.GetValueOnGameThread();
+}
+
+bool FSdSingletonPrewarmProfile::IsPrewarmEnabled()
+{
+	return CVarSdPrewarmEnable.GetValueOnGameThread();
+}
+
+float FSdSingletonPrewarmProfile::GetPrewarmBudgetSeconds()
+{
+	return FMath::Max(CVarSdPrewarmBudgetMs.GetValueOnGameThread(), 0.f) / 1000.f;
+}
+
+FString FSdSingletonPrewarmProfile::GetProfileMapName(const UWorld* InWorld)
+{
+	return FPackageName::GetShortName(UWorld::RemovePIEPrefix(InWorld->GetOutermost()->GetName()));
+}
+
+FString FSdSingletonPrewarmProfile::GetProfilePath(const FString& InMapName, bool bContentDir)
+{
+	const FString RootDir = bContentDir ? FPaths::ProjectContentDir() : FPaths::ProjectSavedDir();
+	return FPaths::Combine(RootDir, TEXT("SingletonUtil"), TEXT("Prewarm"), InMapName + TEXT(".sdprewarm"));
+}
+
+void FSdSingletonPrewarmProfile::RecordAccess(ESdPrewarmKeyKind InKind, const UClass* InClass, bool bMiss, bool bScan)
+{
+	if (!InClass)
+	{
+		return;
+	}
+
+	const TPair<uint8, const UClass*> RecordKey(uint8(InKind), InClass);
+	int32*							  EntryIndex = RecordedEntryIndices.Find(RecordKey);
+	if (!EntryIndex)
+	{
+		EntryIndex = &RecordedEntryIndices.Add(RecordKey, FindOrAddEntry(InKind, FSoftClassPath(InClass)));
+	}
+
+	FSdPrewarmEntry& Entry = Entries[*EntryIndex];
+	Entry.Requests++;
+	Entry.Misses += bMiss ? 1 : 0;
+	Entry.Scans += bScan ? 1 : 0;
+}
+
+int32 FSdSingletonPrewarmProfile::FindOrAddEntry(ESdPrewarmKeyKind InKind, const FSoftClassPath& InClassPath)
+{
+	const int32 ExistingIndex = Entries.IndexOfByPredicate([InKind, &InClassPath](const FSdPrewarmEntry& Entry) { return Entry.Kind == InKind && Entry.ClassPath == InClassPath; });
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	const int32		 NewIndex = Entries.AddDefaulted();
+	FSdPrewarmEntry& NewEntry = Entries[NewIndex];
+	NewEntry.Kind = InKind;
+	NewEntry.ClassPath = InClassPath;
+	return NewIndex;
+}
+
+bool FSdSingletonPrewarmProfile::LoadForMap(const FString& InMapName)
+{
+	Reset();
+	return LoadFromFile(GetProfilePath(InMapName, true)) || LoadFromFile(GetProfilePath(InMapName, false));
+}
+
+bool FSdSingletonPrewarmProfile::LoadFromFile(const FString& InPath)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *InPath) || Lines.Num() == 0 || Lines[0] != SdSingletonPrewarm::FileHeader)
+	{
+		return false;
+	}
+
+	// one key per line: <Kind> <Requests> <Misses> <Scans> <ClassPath>
+	for (int32 LineIndex = 1; LineIndex < Lines.Num(); ++LineIndex)
+	{
+		TArray<FString> Fields;
+		if (Lines[LineIndex].ParseIntoArrayWS(Fields) != 5 || Fields[0].Len() != 1)
+		{
+			continue;
+		}
+
+		const int32 KindIndex = UE_ARRAY_COUNT(SdSingletonPrewarm::KindChars) - 1;
+		int32		Kind = KindIndex;
+		while (Kind >= 0 && SdSingletonPrewarm::KindChars[Kind] != Fields[0][0])
+		{
+			Kind--;
+		}
+		if (Kind < 0)
+		{
+			continue;
+		}
+
+		FSdPrewarmEntry& Entry = Entries[FindOrAddEntry(ESdPrewarmKeyKind(Kind), FSoftClassPath(Fields[4]))];
+		Entry.Requests += FCString::Atoi(*Fields[1]);
+		Entry.Misses += FCString::Atoi(*Fields[2]);
+		Entry.Scans += FCString::Atoi(*Fields[3]);
+	}
+
+	SortEntries();
+	return true;
+}
+
+bool FSdSingletonPrewarmProfile::SaveForMap(const FString& InMapName)
+{
+	if (IsEmpty())
+	{
+		return false;
+	}
+
+	const FString SavePath = GetProfilePath(InMapName, false);
+
+	FSdSingletonPrewarmProfile MergedProfile;
+	MergedProfile.LoadFromFile(SavePath);
+	for (const FSdPrewarmEntry& Entry : Entries)
+	{
+		FSdPrewarmEntry& MergedEntry = MergedProfile.Entries[MergedProfile.FindOrAddEntry(Entry.Kind, Entry.ClassPath)];
+		MergedEntry.Requests += Entry.Requests;
+		MergedEntry.Misses += Entry.Misses;
+		MergedEntry.Scans += Entry.Scans;
+	}
+	MergedProfile.SortEntries();
+
+	TArray<FString> Lines;
+	Lines.Reserve(MergedProfile.Entries.Num() + 1);
+	Lines.Add(SdSingletonPrewarm::FileHeader);
+	for (const FSdPrewarmEntry& Entry : MergedProfile.Entries)
+	{
+		Lines.Add(FString::Printf(TEXT("%c %u %u %u %s"), SdSingletonPrewarm::KindChars[uint8(Entry.Kind)], Entry.Requests, Entry.Misses, Entry.Scans, *Entry.ClassPath.ToString()));
+	}
+
+	// counts are now in the file, keep recording from zero
+	Reset();
+	return FFileHelper::SaveStringArrayToFile(Lines, *SavePath);
+}
+
+void FSdSingletonPrewarmProfile::SortEntries()
+{
+	Entries.StableSort([](const FSdPrewarmEntry& A, const FSdPrewarmEntry& B)
+		{
+			return A.Misses != B.Misses ? A.Misses > B.Misses : A.Scans > B.Scans;
+		});
+	RecordedEntryIndices.Empty();
+}
+
+void FSdSingletonPrewarmProfile::Reset()
+{
+	Entries.Empty();
+	RecordedEntryIndices.Empty();
+}
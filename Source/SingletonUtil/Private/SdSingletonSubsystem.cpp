@@ -2,42 +2,566 @@
 
 
 #include "SdSingletonSubsystem.h"
+#include "SdSingletonClassMetadata.h"
+#include "SdSingletonMissAttribution.h"
 
 #include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/AssetManager.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+#include "Async/Async.h"
 #include <Kismet/GameplayStatics.h>
 
 
+namespace SdSingletonSubsystem
+{
+	static float MillisecondsSince(double StartSeconds)
+	{
+		return float((FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+	}
+
+	static void AttributeMissScan(const UClass* Key, double ScanStartSeconds)
+	{
+		if (FSdSingletonMissAttribution::IsEnabled())
+		{
+			FSdSingletonMissAttribution::Get().RecordScan(Key, MillisecondsSince(ScanStartSeconds));
+		}
+	}
+
+	template <typename KeyType>
+	static void MarkCacheEntryHit(TMap<KeyType, FSdSingletonCacheEntry>& CacheEntries, const KeyType& Key)
+	{
+		if (FSdSingletonCacheEntry* CacheEntry = CacheEntries.Find(Key))
+		{
+			CacheEntry->MarkHit();
+		}
+	}
+
+	static bool PassesSearchParams(UObject* Object, const FSD_SingletonSearchParams& SearchParams)
+	{
+		if (!IsValid(Object))
+		{
+			return false;
+		}
+
+		if (Object->IsTemplate(RF_ClassDefaultObject))
+		{
+			if (!SearchParams.bShouldIncludeDefaultObjects)
+			{
+				return false;
+			}
+		}
+		else if (SearchParams.bOnlyDefaultObjects)
+		{
+			return false;
+		}
+
+		if (SearchParams.bOnlyGCObjects && GUObjectArray.IsDisregardForGC(Object))
+		{
+			return false;
+		}
+
+		if (SearchParams.bOnlyRootObjects && !Object->IsRooted())
+		{
+			return false;
+		}
+
+		if (SearchParams.FilterClass && !Object->IsA(SearchParams.FilterClass))
+		{
+			return false;
+		}
+
+		if (!SearchParams.FilterString.IsEmpty() && !Object->GetName().Contains(SearchParams.FilterString))
+		{
+			return false;
+		}
+
+		if (!SearchParams.bIncludeTransient)
+		{
+			UPackage* ContainerPackage = Object->GetOutermost();
+			if (ContainerPackage == GetTransientPackage() || ContainerPackage->HasAnyFlags(RF_Transient))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// cache miss strategies of each lookup, in order of preference. Strategies of a lookup always find the same singleton.
+	// Actors and components only have the actor iterator, the class hash would visit the same actors in the same order
+	constexpr ESdLookupStrategy ActorScanStrategies[] = { ESdLookupStrategy::WorldActorScan };
+	constexpr ESdLookupStrategy ComponentScanStrategies[] = { ESdLookupStrategy::WorldActorScan };
+	constexpr ESdLookupStrategy InterfaceScanStrategies[] = { ESdLookupStrategy::ClassHashScan, ESdLookupStrategy::ObjectArrayScan };
+
+	// The original lookup: the first component of the class on the first actor, in actor iterator order, that has one.
+	// The class hash cannot tell which owner the iterator reaches first, so components are only found this way
+	static UActorComponent* FindComponent(const UWorld* SingletonWorld, UClass* Class)
+	{
+		TArray<AActor*> WorldActors;
+		UGameplayStatics::GetAllActorsOfClass(SingletonWorld, AActor::StaticClass(), WorldActors);
+		for (AActor* ActorRef : WorldActors)
+		{
+			UActorComponent* ActorComp = ActorRef->GetComponentByClass(Class);
+			if (ActorComp && IsValid(ActorComp))
+			{
+				return ActorComp;
+			}
+		}
+		return nullptr;
+	}
+
+	static UObject* FindInterfaceObject(const UWorld* SingletonWorld, FSdInterfaceInstanceIndex& InstanceIndex, UClass* InterfaceClass, const FSD_SingletonSearchParams& SearchParams, ESdLookupStrategy Strategy)
+	{
+		if (Strategy == ESdLookupStrategy::ObjectArrayScan)
+		{
+			for (TObjectIterator<UObject> It(RF_NoFlags); It; ++It)
+			{
+				UObject*	  Object = *It;
+				const UClass* ObjectClass = Object->GetClass();
+				if (ObjectClass->ImplementsInterface(InterfaceClass) && !ObjectClass->HasAnyClassFlags(CLASS_NewerVersionExists) && FSdInterfaceInstanceIndex::IsInWorldScope(Object, SingletonWorld) && PassesSearchParams(Object, SearchParams))
+				{
+					return Object;
+				}
+			}
+			return nullptr;
+		}
+
+		// only this world's instances of classes implementing the interface are visited, and the lowest object index
+		// is kept, which is the object the full object array scan would have found first
+		return InstanceIndex.FindFirstInstance(InterfaceClass, [&SearchParams](UObject* Object) { return PassesSearchParams(Object, SearchParams); });
+	}
+} // namespace SdSingletonSubsystem
+
 
 void USdSingletonSubsystem::PostInitialize()
 {
 	ClearLookupCache();
 	Super::PostInitialize();
+
+	InterfaceInstanceIndex.Initialize(GetWorld());
+	ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &USdSingletonSubsystem::OnActorSpawned));
+	ActorDestroyedHandle = GetWorld()->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateUObject(this, &USdSingletonSubsystem::OnActorDestroyed));
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &USdSingletonSubsystem::OnLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &USdSingletonSubsystem::OnLevelChanged);
+}
+
+void USdSingletonSubsystem::Deinitialize()
+{
+	if (UWorld* SingletonWorld = GetWorld())
+	{
+		SingletonWorld->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+		SingletonWorld->RemoveOnActorDestroyedHandler(ActorDestroyedHandle);
+	}
+	ActorSpawnedHandle.Reset();
+	ActorDestroyedHandle.Reset();
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	LevelAddedHandle.Reset();
+	LevelRemovedHandle.Reset();
+	InterfaceInstanceIndex.Deinitialize();
+	if (AvailabilityTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AvailabilityTickerHandle);
+		AvailabilityTickerHandle.Reset();
+	}
+	AvailabilityWatches.Empty();
+	LostAvailabilityKeys.Empty();
+	bHasAvailabilityWatches = false;
+	InitializedSingletons.Empty();
+	StopPrewarm();
+	SavePrewarmProfile();
+	Super::Deinitialize();
+}
+
+void USdSingletonSubsystem::OnActorSpawned(AActor* InActor)
+{
+	ActorResolutionIndex.OnActorSpawned(InActor);
+
+	if (AvailabilityWatches.Num() == 0 || !IsValid(InActor))
+	{
+		return;
+	}
+
+	// the spawned actor is checked against every waiting key directly, without a lookup. Actor keys take the preferred
+	// actor the resolution index just ranked it against when the class is tracked. Found singletons are collected first,
+	// subscribers may watch new keys while being notified
+	TArray<TPair<FSdAvailabilityKey, UObject*>, TInlineAllocator<16>> FoundSingletons;
+	for (const auto& WatchItx : AvailabilityWatches)
+	{
+		if (IsValid(WatchItx.Value->Current.Get()))
+		{
+			continue;
+		}
+
+		UClass*	 KeyClass = const_cast<UClass*>(WatchItx.Key.Class);
+		UObject* FoundSingleton = nullptr;
+		switch (WatchItx.Value->KeyKind)
+		{
+			case ESdAvailabilityKeyKind::Actor:
+				if (InActor->IsA(KeyClass))
+				{
+					AActor* PreferredActor = ActorResolutionIndex.FindPreferredActor(KeyClass);
+					FoundSingleton = PreferredActor ? PreferredActor : InActor;
+				}
+				break;
+			case ESdAvailabilityKeyKind::Component:
+				FoundSingleton = InActor->FindComponentByClass(KeyClass);
+				break;
+			case ESdAvailabilityKeyKind::Interface:
+				if (InActor->GetClass()->ImplementsInterface(KeyClass))
+				{
+					FoundSingleton = InActor;
+					break;
+				}
+				for (UActorComponent* ActorComp : InActor->GetComponents())
+				{
+					if (ActorComp && ActorComp->GetClass()->ImplementsInterface(KeyClass))
+					{
+						FoundSingleton = ActorComp;
+						break;
+					}
+				}
+				break;
+			default:
+				break;
+		}
+		if (FoundSingleton)
+		{
+			FoundSingletons.Emplace(WatchItx.Key, FoundSingleton);
+		}
+	}
+
+	for (const auto& FoundSingleton : FoundSingletons)
+	{
+		NotifySingletonFound(FoundSingleton.Key, FoundSingleton.Value);
+	}
+}
+
+void USdSingletonSubsystem::OnLevelAdded(ULevel* InLevel, UWorld* InWorld)
+{
+	// objects of a removed level simply drop out of the interface index once they are destroyed
+	if (InWorld == GetWorld())
+	{
+		InterfaceInstanceIndex.AddLevelObjects(InLevel);
+	}
+	OnLevelChanged(InLevel, InWorld);
+}
+
+void USdSingletonSubsystem::OnLevelChanged(ULevel* InLevel, UWorld* InWorld)
+{
+	// a null level means the whole world, with every level in it, is being torn down
+	if (InWorld != GetWorld() || !InLevel)
+	{
+		return;
+	}
+
+	TSet<const UClass*> ActorClasses;
+	TSet<const UClass*> ComponentClasses;
+	for (const AActor* LevelActor : InLevel->Actors)
+	{
+		if (!LevelActor)
+		{
+			continue;
+		}
+		ActorClasses.Add(LevelActor->GetClass());
+		for (const UActorComponent* ActorComp : LevelActor->GetComponents())
+		{
+			if (ActorComp)
+			{
+				ComponentClasses.Add(ActorComp->GetClass());
+			}
+		}
+	}
+
+	const auto IsAnyChildOf = [](const TSet<const UClass*>& InClasses, const UClass* InKey)
+	{
+		for (const UClass* Class : InClasses)
+		{
+			if (Class->IsChildOf(InKey))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+	const auto ImplementsAny = [](const TSet<const UClass*>& InClasses, const UClass* InInterface)
+	{
+		for (const UClass* Class : InClasses)
+		{
+			if (Class->ImplementsInterface(InInterface))
+			{
+				return true;
+			}
+		}
+		return false;
+	};
+
+	for (const UClass* ActorClass : ActorClasses)
+	{
+		ActorResolutionIndex.InvalidateActorClass(ActorClass);
+	}
+	for (auto MapItx = SingletonActorCacheMap.CreateIterator(); MapItx; ++MapItx)
+	{
+		if (IsAnyChildOf(ActorClasses, MapItx.Key()))
+		{
+			ActorCacheEntries.Remove(MapItx.Key());
+			MapItx.RemoveCurrent();
+		}
+	}
+	for (auto MapItx = SingletonComponentCacheMap.CreateIterator(); MapItx; ++MapItx)
+	{
+		if (IsAnyChildOf(ComponentClasses, MapItx.Key()))
+		{
+			ComponentCacheEntries.Remove(MapItx.Key());
+			MapItx.RemoveCurrent();
+		}
+	}
+	for (auto MapItx = SingletonInterfaceCacheMap.CreateIterator(); MapItx; ++MapItx)
+	{
+		const UClass* InterfaceClass = MapItx.Key().InterfaceClass.Get();
+		if (!InterfaceClass || ImplementsAny(ActorClasses, InterfaceClass) || ImplementsAny(ComponentClasses, InterfaceClass))
+		{
+			InterfaceCacheEntries.Remove(MapItx.Key());
+			MapItx.RemoveCurrent();
+		}
+	}
 }
+
+void USdSingletonSubsystem::OnActorDestroyed(AActor* InActor)
+{
+	// a new instance spawned later, after a level reload for instance, has to be initialized again
+	if (InitializedSingletons.Num() > 0 && IsValid(InActor))
+	{
+		InitializedSingletons.Remove(FObjectKey(InActor));
+		for (UActorComponent* ActorComp : InActor->GetComponents())
+		{
+			InitializedSingletons.Remove(FObjectKey(ActorComp));
+		}
+	}
+
+	if (AvailabilityWatches.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FSdAvailabilityKey, TInlineAllocator<16>> LostKeys;
+	for (const auto& WatchItx : AvailabilityWatches)
+	{
+		UObject* Current = WatchItx.Value->Current.Get();
+		if (Current && (Current == InActor || Current->GetTypedOuter<AActor>() == InActor))
+		{
+			LostKeys.Add(WatchItx.Key);
+		}
+	}
+
+	// the destroyed actor is still valid while this event runs, another instance is looked up on the next tick
+	for (const FSdAvailabilityKey& LostKey : LostKeys)
+	{
+		NotifySingletonLost(LostKey);
+		LostAvailabilityKeys.AddUnique(LostKey);
+	}
+}
+
+bool USdSingletonSubsystem::TickAvailabilityWatches(float DeltaTime)
+{
+	// weak pointers go null as soon as their object is marked as garbage, which catches destroyed components
+	// and collected global objects without any scan
+	TArray<FSdAvailabilityKey, TInlineAllocator<16>> StaleKeys;
+	for (const auto& WatchItx : AvailabilityWatches)
+	{
+		const TWeakObjectPtr<UObject>& Current = WatchItx.Value->Current;
+		if (!Current.IsExplicitlyNull() && !IsValid(Current.Get()))
+		{
+			StaleKeys.Add(WatchItx.Key);
+		}
+	}
+	for (const FSdAvailabilityKey& StaleKey : StaleKeys)
+	{
+		NotifySingletonLost(StaleKey);
+		LostAvailabilityKeys.AddUnique(StaleKey);
+	}
+
+	const UWorld* SingletonWorld = GetWorld();
+	if (LostAvailabilityKeys.Num() == 0 || !SingletonWorld || SingletonWorld->bIsTearingDown)
+	{
+		return true;
+	}
+
+	TArray<FSdAvailabilityKey, TInlineAllocator<8>> KeysToResolve = MoveTemp(LostAvailabilityKeys);
+	LostAvailabilityKeys.Reset();
+	for (const FSdAvailabilityKey& LostKey : KeysToResolve)
+	{
+		const TSharedRef<FSdAvailabilityWatch>* FoundWatch = AvailabilityWatches.Find(LostKey);
+		if (FoundWatch && (*FoundWatch)->Current.IsExplicitlyNull())
+		{
+			FindAvailableSingleton(LostKey, (*FoundWatch)->KeyKind);
+		}
+	}
+	return true;
+}
+
 void USdSingletonSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
 	ClearLookupCache();
+	StartPrewarm();
 	Super::OnWorldBeginPlay(InWorld);
 }
 
+void USdSingletonSubsystem::StartPrewarm()
+{
+	StopPrewarm();
+
+	if (!FSdSingletonPrewarmProfile::IsPrewarmEnabled() || !PrewarmProfile.LoadForMap(FSdSingletonPrewarmProfile::GetProfileMapName(GetWorld())))
+	{
+		return;
+	}
+
+	RunPrewarm(FSdSingletonPrewarmProfile::GetPrewarmBudgetSeconds());
+	if (PrewarmCursor < PrewarmProfile.GetEntries().Num())
+	{
+		PrewarmTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &USdSingletonSubsystem::TickPrewarm));
+	}
+}
+
+bool USdSingletonSubsystem::TickPrewarm(float DeltaTime)
+{
+	RunPrewarm(FSdSingletonPrewarmProfile::GetPrewarmBudgetSeconds());
+	if (PrewarmCursor < PrewarmProfile.GetEntries().Num())
+	{
+		return true;
+	}
+
+	PrewarmTickerHandle.Reset();
+	PrewarmProfile.Reset();
+	return false;
+}
+
+void USdSingletonSubsystem::RunPrewarm(double BudgetSeconds)
+{
+	TGuardValue<bool> PrewarmGuard(bRunningPrewarm, true);
+
+	const TArray<FSdPrewarmEntry>& Entries = PrewarmProfile.GetEntries();
+	const double				   StartSeconds = FPlatformTime::Seconds();
+	while (PrewarmCursor < Entries.Num())
+	{
+		const FSdPrewarmEntry& Entry = Entries[PrewarmCursor++];
+
+		// prewarming never loads anything, keys of classes which are not loaded yet have no singleton to find either
+		if (UClass* KeyClass = Entry.ClassPath.ResolveClass())
+		{
+			switch (Entry.Kind)
+			{
+				case ESdPrewarmKeyKind::Actor:
+					if (KeyClass->IsChildOf(AActor::StaticClass()))
+					{
+						K2_GetSingletonActor(KeyClass, false, false);
+					}
+					break;
+				case ESdPrewarmKeyKind::Component:
+					if (KeyClass->IsChildOf(UActorComponent::StaticClass()))
+					{
+						K2_GetSingletonComponent(KeyClass, false);
+					}
+					break;
+				case ESdPrewarmKeyKind::Interface:
+					if (KeyClass->HasAnyClassFlags(CLASS_Interface))
+					{
+						UObject* FoundObject = nullptr;
+						K2_GetSingletonInterface(KeyClass, FoundObject, FSD_SingletonSearchParams(), false);
+					}
+					break;
+				default:
+					break;
+			}
+		}
+
+		if (BudgetSeconds >= 0.0 && FPlatformTime::Seconds() - StartSeconds >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+}
+
+void USdSingletonSubsystem::StopPrewarm()
+{
+	if (PrewarmTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(PrewarmTickerHandle);
+		PrewarmTickerHandle.Reset();
+	}
+	PrewarmProfile.Reset();
+	PrewarmCursor = 0;
+}
+
+bool USdSingletonSubsystem::SavePrewarmProfile()
+{
+	const UWorld* SingletonWorld = GetWorld();
+	if (!SingletonWorld || RecordedPrewarmProfile.IsEmpty())
+	{
+		return false;
+	}
+	return RecordedPrewarmProfile.SaveForMap(FSdSingletonPrewarmProfile::GetProfileMapName(SingletonWorld));
+}
+
+void USdSingletonSubsystem::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	CastChecked<USdSingletonSubsystem>(InThis)->GlobalObjectRegistry.AddReferencedObjects(Collector);
+	Super::AddReferencedObjects(InThis, Collector);
+}
+
 void USdSingletonSubsystem::ClearLookupCache()
 {
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
 	CacheMap.Empty();
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
 	SingletonActorCacheMap.Empty();
 	SingletonComponentCacheMap.Empty();
-	GlobalObjectRegistry.RegisteredObjects.Empty();
+	GlobalObjectRegistry.Empty();
 	SingletonInterfaceCacheMap.Empty();
+	ActorCacheEntries.Empty();
+	ComponentCacheEntries.Empty();
+	InterfaceCacheEntries.Empty();
+	ActorResolutionIndex.Reset();
+	InterfaceInstanceIndex.Reset();
+
+	// registry entries are gone with the registry, world singletons are still alive and stay available
+	TArray<FSdAvailabilityKey, TInlineAllocator<16>> LostKeys;
+	for (const auto& WatchItx : AvailabilityWatches)
+	{
+		if (WatchItx.Value->KeyKind == ESdAvailabilityKeyKind::GlobalObject && WatchItx.Value->Current.IsValid())
+		{
+			LostKeys.Add(WatchItx.Key);
+		}
+	}
+	for (const FSdAvailabilityKey& LostKey : LostKeys)
+	{
+		NotifySingletonLost(LostKey);
+	}
 }
 
 void USdSingletonSubsystem::CacheLookupResult(TSubclassOf<UObject> Class, TArray<UClass*> Results)
 {
-	if (!CacheMap.Contains(Class))
+	FSdSingletonClassMetadata::Get().AddDerivedClasses(Class, Results);
+	MirrorToDeprecatedCacheMap(Class, FSdSingletonClassMetadata::Get().GetDerivedClasses(Class), true);
+}
+
+void USdSingletonSubsystem::MirrorToDeprecatedCacheMap(TSubclassOf<UObject> Class, const TArray<UClass*>& ChildClasses, bool bOverwrite)
+{
+PRAGMA_DISABLE_DEPRECATION_WARNINGS
+	// lookups after the first only pay for the hash lookup
+	FSdDerivedClassCache* MirroredClasses = CacheMap.Find(Class);
+	if (!MirroredClasses)
 	{
-		CacheMap.Add(Class, FSdDerivedClassCache());
+		CacheMap.Add(Class).Classes = ChildClasses;
 	}
-	for (auto& Result : Results)
+	else if (bOverwrite)
 	{
-		CacheMap[Class].Classes.AddUnique(Result);
+		MirroredClasses->Classes = ChildClasses;
 	}
+PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
 
@@ -51,13 +575,10 @@ TArray<UClass*> USdSingletonSubsystem::GetDerivedClassesFromObject(UObject* Oute
 
 	TSubclassOf<UObject> Class = GetClass();
 
-	if (CacheMap.Contains(Class))
-	{
-		return CacheMap[Class].Classes;
-	}
-
-	GetDerivedClasses(Class, ChildClasses, false);
-	CacheLookupResult(Class, ChildClasses);
+	bool bCacheHit = false;
+	ChildClasses = FSdSingletonClassMetadata::Get().GetDerivedClasses(Class, &bCacheHit);
+	(bCacheHit ? DerivedClassCacheCounters.Hits : DerivedClassCacheCounters.Misses)++;
+	MirrorToDeprecatedCacheMap(Class, ChildClasses);
 	return ChildClasses;
 }
 
@@ -70,13 +591,10 @@ TArray<UClass*> USdSingletonSubsystem::K2_GetDerivedClassesFromClass(TSubclassOf
 		return ChildClasses;
 	}
 
-	if (CacheMap.Contains(Class))
-	{
-		return CacheMap[Class].Classes;
-	}
-
-	GetDerivedClasses(Class, ChildClasses, false);
-	CacheLookupResult(Class, ChildClasses);
+	bool bCacheHit = false;
+	ChildClasses = FSdSingletonClassMetadata::Get().GetDerivedClasses(Class, &bCacheHit);
+	(bCacheHit ? DerivedClassCacheCounters.Hits : DerivedClassCacheCounters.Misses)++;
+	MirrorToDeprecatedCacheMap(Class, ChildClasses);
 	return ChildClasses;
 }
 
@@ -92,93 +610,64 @@ TScriptInterface<UInterface> USdSingletonSubsystem::K2_GetSingletonInterface(TSu
 		return OutInterface;
 	}
 
-	if (!bIgnoreCache && SingletonInterfaceCacheMap.Contains(SingletonInterfaceHashKey))
+	// only lookups with default search params are recorded for prewarming, which is how the profile replays them
+	const bool bIsDefaultSearch = SearchParams == FSD_SingletonSearchParams();
+
+	const bool bUseCache = !bIgnoreCache && !FSdLookupStrategySelector::IsCacheDisabled();
+	UObject**  CachedObjectPtr = bUseCache ? SingletonInterfaceCacheMap.Find(SingletonInterfaceHashKey) : nullptr;
+	if (CachedObjectPtr)
 	{
-		UObject* CachedObject = SingletonInterfaceCacheMap[SingletonInterfaceHashKey];
+		UObject* CachedObject = *CachedObjectPtr;
 		if (CachedObject && IsValid(CachedObject))
 		{
+			SdSingletonSubsystem::MarkCacheEntryHit(InterfaceCacheEntries, SingletonInterfaceHashKey);
+			InterfaceCacheCounters.Hits++;
+			if (bIsDefaultSearch)
+			{
+				RecordPrewarmAccess(ESdPrewarmKeyKind::Interface, InInterfaceClass, false, false);
+			}
 			OutInterface.SetObject(CachedObject);
 			OutInterface = CachedObject;
 			OutObject = CachedObject;
 			return OutInterface;
 		}
 	}
-
-	if (SearchParams.bIncludeOnlyActors)
+	InterfaceCacheCounters.Misses++;
+	if (bIsDefaultSearch)
 	{
-		TArray<AActor*> WorldActors;
-		const UWorld*	SingletonWorld = GetWorld();
-
-		UGameplayStatics::GetAllActorsWithInterface(SingletonWorld, InInterfaceClass, WorldActors);
-		for (auto ActorRef : WorldActors)
-		{
-			OutInterface.SetObject(ActorRef);
-			SingletonInterfaceCacheMap.Add(SingletonInterfaceHashKey, ActorRef);
-			OutInterface = ActorRef;
-			OutObject = ActorRef;
-			break;
-		}
-	}
-	else
-	{
-
-		UObject*  CheckOuter = nullptr;
-		UPackage* InsidePackage = nullptr;
-		for (FThreadSafeObjectIterator It; It; ++It)
-		{
-			if (!It->GetClass()->ImplementsInterface(SingletonInterfaceHashKey.InterfaceClass))
-			{
-				continue;
-			}
-
-			if (It->IsTemplate(RF_ClassDefaultObject))
-			{
-				if (!SearchParams.bShouldIncludeDefaultObjects)
-				{
-					continue;
-				}
-			}
-			else if (SearchParams.bOnlyDefaultObjects)
-			{
-				continue;
-			}
-
-			if (SearchParams.bOnlyGCObjects && GUObjectArray.IsDisregardForGC(*It))
-			{
-				continue;
-			}
-
-			if (SearchParams.bOnlyRootObjects && !It->IsRooted())
-			{
-				continue;
-			}
-
-			if (SearchParams.FilterClass && !It->IsA(SearchParams.FilterClass))
-			{
-				continue;
-			}
+		RecordPrewarmAccess(ESdPrewarmKeyKind::Interface, InInterfaceClass, true, true);
+	}
 
-			if (!SearchParams.FilterString.IsEmpty() && !It->GetName().Contains(SearchParams.FilterString))
-			{
-				continue;
-			}
+	const double  ScanStartSeconds = FPlatformTime::Seconds();
+	const UWorld* SingletonWorld = GetWorld();
+	UObject*	  FoundInterfaceObject = nullptr;
 
-			if (!SearchParams.bIncludeTransient)
-			{
-				UPackage* ContainerPackage = It->GetOutermost();
-				if (ContainerPackage == GetTransientPackage() || ContainerPackage->HasAnyFlags(RF_Transient))
-				{
-					continue;
-				}
-			}
+	if (SearchParams.bIncludeOnlyActors)
+	{
+		TArray<AActor*> WorldActors;
+		UGameplayStatics::GetAllActorsWithInterface(SingletonWorld, InInterfaceClass, WorldActors);
+		FoundInterfaceObject = WorldActors.Num() > 0 ? WorldActors[0] : nullptr;
+	}
+	else
+	{
+		const ESdLookupStrategy Strategy = LookupStrategySelector.SelectStrategy(InInterfaceClass, ESdLookupKind::Interface, SdSingletonSubsystem::InterfaceScanStrategies);
+		FoundInterfaceObject = SdSingletonSubsystem::FindInterfaceObject(SingletonWorld, InterfaceInstanceIndex, InInterfaceClass, SearchParams, Strategy);
+		LookupStrategySelector.RecordCost(InInterfaceClass, ESdLookupKind::Interface, Strategy, SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds));
+	}
+	SdSingletonSubsystem::AttributeMissScan(InInterfaceClass, ScanStartSeconds);
 
-			auto FoundInterfaceObject = *It;
-			OutInterface.SetObject(FoundInterfaceObject);
-			SingletonInterfaceCacheMap.Add(SingletonInterfaceHashKey, FoundInterfaceObject);
-			OutInterface = FoundInterfaceObject;
-			OutObject = FoundInterfaceObject;
-			break;
+	if (FoundInterfaceObject)
+	{
+		OutInterface.SetObject(FoundInterfaceObject);
+		SingletonInterfaceCacheMap.Add(SingletonInterfaceHashKey, FoundInterfaceObject);
+		InterfaceCacheEntries.Add(SingletonInterfaceHashKey, FSdSingletonCacheEntry(SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds)));
+		// filtered lookups answer a narrower question than the watch, only the default search reports what it found
+		if (bIsDefaultSearch)
+		{
+			NotifySingletonFound(FSdAvailabilityKey{ InInterfaceClass }, FoundInterfaceObject);
 		}
+		OutInterface = FoundInterfaceObject;
+		OutObject = FoundInterfaceObject;
 	}
 
 	return OutInterface;
@@ -193,30 +682,34 @@ UActorComponent* USdSingletonSubsystem::K2_GetSingletonComponent(TSubclassOf<UAc
 		return OutComponent;
 	}
 
-	if (SingletonComponentCacheMap.Contains(Class))
+	UActorComponent** CachedComponentPtr = FSdLookupStrategySelector::IsCacheDisabled() ? nullptr : SingletonComponentCacheMap.Find(Class);
+	if (CachedComponentPtr)
 	{
-		UObject* CachedObject = SingletonComponentCacheMap[Class];
-		if (CachedObject && IsValid(CachedObject))
+		UActorComponent* CachedComponent = *CachedComponentPtr;
+		if (CachedComponent && IsValid(CachedComponent))
 		{
-			return SingletonComponentCacheMap[Class];
+			SdSingletonSubsystem::MarkCacheEntryHit(ComponentCacheEntries, TSubclassOf<UObject>(Class));
+			ComponentCacheCounters.Hits++;
+			RecordPrewarmAccess(ESdPrewarmKeyKind::Component, Class, false, false);
+			return CachedComponent;
 		}
 	}
+	ComponentCacheCounters.Misses++;
+	RecordPrewarmAccess(ESdPrewarmKeyKind::Component, Class, true, true);
 
-	TArray<AActor*> WorldActors;
+	const double ScanStartSeconds = FPlatformTime::Seconds();
 
-	const UWorld* SingletonWorld = GetWorld();
+	const ESdLookupStrategy Strategy = LookupStrategySelector.SelectStrategy(Class, ESdLookupKind::Component, SdSingletonSubsystem::ComponentScanStrategies);
+	OutComponent = SdSingletonSubsystem::FindComponent(GetWorld(), Class);
+	LookupStrategySelector.RecordCost(Class, ESdLookupKind::Component, Strategy, SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds));
+	SdSingletonSubsystem::AttributeMissScan(Class, ScanStartSeconds);
 
-	UGameplayStatics::GetAllActorsOfClass(SingletonWorld, AActor::StaticClass(), WorldActors);
-	for (AActor* ActorRef : WorldActors)
+	if (IsValid(OutComponent))
 	{
-		UActorComponent* ActorComp = ActorRef->GetComponentByClass(Class);
-
-		if (ActorComp && IsValid(ActorComp))
-		{
-			OutComponent = ActorComp;
-			SingletonComponentCacheMap.Add(Class, OutComponent);
-			return OutComponent;
-		}
+		SingletonComponentCacheMap.Add(Class, OutComponent);
+		ComponentCacheEntries.Add(Class, FSdSingletonCacheEntry(SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds)));
+		NotifySingletonFound(FSdAvailabilityKey{ Class }, OutComponent);
+		return OutComponent;
 	}
 
 	if (!IsValid(OutComponent) && bCreateIfMissing)
@@ -225,6 +718,8 @@ UActorComponent* USdSingletonSubsystem::K2_GetSingletonComponent(TSubclassOf<UAc
 		FTransform TempTransform;
 		OutComponent = NewActor->AddComponentByClass(Class, false, TempTransform, false);
 		SingletonComponentCacheMap.Add(Class, OutComponent);
+		ComponentCacheEntries.Add(Class, FSdSingletonCacheEntry(SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds)));
+		NotifySingletonFound(FSdAvailabilityKey{ Class }, OutComponent);
 	}
 
 	return OutComponent;
@@ -239,59 +734,52 @@ AActor* USdSingletonSubsystem::K2_GetSingletonActor(TSubclassOf<AActor> Class, b
 		return OutActor;
 	}
 
-	if (!bIgnoreCache && SingletonActorCacheMap.Contains(Class))
+	const bool bUseCache = !bIgnoreCache && !FSdLookupStrategySelector::IsCacheDisabled();
+	AActor**   CachedActorPtr = bUseCache ? SingletonActorCacheMap.Find(Class) : nullptr;
+	if (CachedActorPtr)
 	{
-		UObject* CachedObject = SingletonActorCacheMap[Class];
-		if (CachedObject && IsValid(CachedObject))
+		AActor* CachedActor = *CachedActorPtr;
+		if (CachedActor && IsValid(CachedActor))
 		{
-			return SingletonActorCacheMap[Class];
+			SdSingletonSubsystem::MarkCacheEntryHit(ActorCacheEntries, TSubclassOf<UObject>(Class));
+			ActorCacheCounters.Hits++;
+			RecordPrewarmAccess(ESdPrewarmKeyKind::Actor, Class, false, false);
+			return CachedActor;
 		}
 	}
+	ActorCacheCounters.Misses++;
 
-	bool			bActorFound = false;
-	TArray<AActor*> WorldActors;
-	AActor*			BackupOption = nullptr;
-
-	const UWorld* SingletonWorld = GetWorld();
+	const double ScanStartSeconds = FPlatformTime::Seconds();
 
-	UGameplayStatics::GetAllActorsOfClass(SingletonWorld, Class, WorldActors);
-	for (auto ActorRef : WorldActors)
+	// the resolution index already knows the preferred actor for classes it tracks, spawned actors are ranked as they appear.
+	// It never iterates, so it is always tried first and its cost is only recorded for the report
+	bool					bScanned = false;
+	const ESdLookupStrategy ForcedStrategy = FSdLookupStrategySelector::GetForcedStrategy();
+	if (bUseCache && (ForcedStrategy == ESdLookupStrategy::Auto || ForcedStrategy == ESdLookupStrategy::Index))
 	{
-		// this is for angelscript returning uninstantiated base default objects over world-spawned BP-derived objects
-		// because the .AS objects always seem to be available when calling GetActorsOfClass(), even if they're not in the world
-		// therefore, we iterate through all classes and prefer the deepest level of descendent
-		//
-		// loop through actor classes
-		// check if root component is valid
-		// if iterated actor is a child actor class of backup option class, set backup option class
-
-		if (!IsValid(BackupOption))
+		OutActor = ActorResolutionIndex.FindPreferredActor(Class);
+		if (IsValid(OutActor))
 		{
-			BackupOption = ActorRef;
+			LookupStrategySelector.RecordCost(Class, ESdLookupKind::Actor, ESdLookupStrategy::Index, SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds));
 		}
-		auto ActorClass = ActorRef->GetClass();
-		auto BackupOptionActorClass = BackupOption->GetClass();
-		if (!IsValid(ActorRef->GetRootComponent()))
-		{
-			if (ActorClass->IsChildOf(BackupOptionActorClass))
-			{
-				BackupOption = ActorRef;
-			}
-			continue;
-		}
-		OutActor = ActorRef;
-		bActorFound = true;
-		break;
 	}
 
-	if (!(OutActor && IsValid(OutActor)))
+	if (!IsValid(OutActor))
 	{
-		if ((BackupOption && IsValid(BackupOption)))
-		{
-			OutActor = BackupOption;
-			bActorFound = true;
-		}
+		// this is for angelscript returning uninstantiated base default objects over world-spawned BP-derived objects
+		// because the .AS objects always seem to be available when calling GetActorsOfClass(), even if they're not in the world
+		// therefore candidates are ranked by the class resolution policy, which by default prefers actors with a root component
+		// and otherwise the deepest level of descendent
+		const ESdLookupStrategy Strategy = LookupStrategySelector.SelectStrategy(Class, ESdLookupKind::Actor, SdSingletonSubsystem::ActorScanStrategies);
+
+		TArray<AActor*> WorldActors;
+		UGameplayStatics::GetAllActorsOfClass(GetWorld(), Class, WorldActors);
+		OutActor = ActorResolutionIndex.ResolveFromCandidates(Class, WorldActors);
+		LookupStrategySelector.RecordCost(Class, ESdLookupKind::Actor, Strategy, SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds));
+		SdSingletonSubsystem::AttributeMissScan(Class, ScanStartSeconds);
+		bScanned = true;
 	}
+	RecordPrewarmAccess(ESdPrewarmKeyKind::Actor, Class, true, bScanned);
 
 	if (!bCreateIfMissing && !IsValid(OutActor))
 	{
@@ -306,62 +794,376 @@ AActor* USdSingletonSubsystem::K2_GetSingletonActor(TSubclassOf<AActor> Class, b
 	if (IsValid(OutActor))
 	{
 		SingletonActorCacheMap.Add(Class, OutActor);
+		ActorCacheEntries.Add(Class, FSdSingletonCacheEntry(SdSingletonSubsystem::MillisecondsSince(ScanStartSeconds)));
+		NotifySingletonFound(FSdAvailabilityKey{ Class }, OutActor);
 	}
 
 	return OutActor;
 }
 
+USdSingletonSubsystem::ESdAvailabilityKeyKind USdSingletonSubsystem::GetAvailabilityKeyKind(const UClass* InKey)
+{
+	if (InKey->IsChildOf(AActor::StaticClass()))
+	{
+		return ESdAvailabilityKeyKind::Actor;
+	}
+	if (InKey->IsChildOf(UActorComponent::StaticClass()))
+	{
+		return ESdAvailabilityKeyKind::Component;
+	}
+	if (InKey->HasAnyClassFlags(CLASS_Interface))
+	{
+		return ESdAvailabilityKeyKind::Interface;
+	}
+	return ESdAvailabilityKeyKind::GlobalObject;
+}
+
+USdSingletonSubsystem::FSdAvailabilityKey USdSingletonSubsystem::MakeAvailabilityKey(const UClass* InKey, FName InGlobalId)
+{
+	// only the registry has IDs, every other kind of key resolves the same way whatever the ID
+	const bool bIsGlobalObjectKey = InKey && GetAvailabilityKeyKind(InKey) == ESdAvailabilityKeyKind::GlobalObject;
+	return FSdAvailabilityKey{ InKey, bIsGlobalObjectKey ? InGlobalId : FName(NAME_None) };
+}
+
+TSharedRef<USdSingletonSubsystem::FSdAvailabilityWatch> USdSingletonSubsystem::FindOrAddAvailabilityWatch(const FSdAvailabilityKey& InKey)
+{
+	if (TSharedRef<FSdAvailabilityWatch>* ExistingWatch = AvailabilityWatches.Find(InKey))
+	{
+		return *ExistingWatch;
+	}
+	TSharedRef<FSdAvailabilityWatch> NewWatch = MakeShared<FSdAvailabilityWatch>();
+	NewWatch->KeyKind = GetAvailabilityKeyKind(InKey.Class);
+	AvailabilityWatches.Add(InKey, NewWatch);
+	bHasAvailabilityWatches = true;
+	if (!AvailabilityTickerHandle.IsValid())
+	{
+		AvailabilityTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &USdSingletonSubsystem::TickAvailabilityWatches));
+	}
+	return NewWatch;
+}
+
+UObject* USdSingletonSubsystem::FindAvailableSingleton(const FSdAvailabilityKey& InKey, ESdAvailabilityKeyKind InKeyKind)
+{
+	UClass*	 KeyClass = const_cast<UClass*>(InKey.Class);
+	UObject* FoundObject = nullptr;
+	switch (InKeyKind)
+	{
+		case ESdAvailabilityKeyKind::Actor:
+			FoundObject = K2_GetSingletonActor(KeyClass, false);
+			break;
+		case ESdAvailabilityKeyKind::Component:
+			FoundObject = K2_GetSingletonComponent(KeyClass, false);
+			break;
+		case ESdAvailabilityKeyKind::Interface:
+			K2_GetSingletonInterface(KeyClass, FoundObject);
+			break;
+		case ESdAvailabilityKeyKind::GlobalObject:
+			FoundObject = K2_GetGlobalObjectInRegistry(KeyClass, InKey.GlobalId);
+			break;
+	}
+
+	// cache hits do not notify on their own
+	if (IsValid(FoundObject))
+	{
+		NotifySingletonFound(InKey, FoundObject);
+	}
+	return FoundObject;
+}
+
+void USdSingletonSubsystem::NotifySingletonFound(const FSdAvailabilityKey& InKey, UObject* InSingleton)
+{
+	if (AvailabilityWatches.Num() == 0 || !InKey.Class || !IsValid(InSingleton))
+	{
+		return;
+	}
+
+	TSharedRef<FSdAvailabilityWatch>* FoundWatch = AvailabilityWatches.Find(InKey);
+	if (!FoundWatch)
+	{
+		return;
+	}
+
+	TSharedRef<FSdAvailabilityWatch> Watch = *FoundWatch;
+	UObject*						 Current = Watch->Current.Get();
+	if (Current == InSingleton)
+	{
+		return;
+	}
+	if (!Watch->Current.IsExplicitlyNull())
+	{
+		NotifySingletonLost(InKey);
+	}
+
+	Watch->Current = InSingleton;
+	BroadcastAvailability(InKey, *Watch, InSingleton, true);
+}
+
+void USdSingletonSubsystem::NotifySingletonLost(const FSdAvailabilityKey& InKey)
+{
+	TSharedRef<FSdAvailabilityWatch>* FoundWatch = AvailabilityWatches.Find(InKey);
+	if (!FoundWatch || (*FoundWatch)->Current.IsExplicitlyNull())
+	{
+		return;
+	}
+
+	// keep the watch alive while subscribers run, they may add or remove watches
+	TSharedRef<FSdAvailabilityWatch> Watch = *FoundWatch;
+	UObject*						 LostSingleton = Watch->Current.Get();
+	Watch->Current.Reset();
+	BroadcastAvailability(InKey, *Watch, LostSingleton, false);
+}
+
+void USdSingletonSubsystem::BroadcastAvailability(const FSdAvailabilityKey& InKey, FSdAvailabilityWatch& InWatch, UObject* InSingleton, bool bAvailable)
+{
+	InWatch.BlueprintEvents.RemoveAll([](const FSdOnSingletonAvailability& Event) { return !Event.IsBound(); });
+
+	TArray<FSdOnSingletonAvailability> BlueprintEvents = InWatch.BlueprintEvents;
+	for (const FSdOnSingletonAvailability& Event : BlueprintEvents)
+	{
+		Event.ExecuteIfBound(InSingleton, bAvailable);
+	}
+	InWatch.NativeEvent.Broadcast(InSingleton, bAvailable);
+	OnSingletonAvailabilityChanged.Broadcast(const_cast<UClass*>(InKey.Class), InSingleton, bAvailable);
+}
+
+void USdSingletonSubsystem::WatchSingletonAvailability(UClass* InKey, FSdOnSingletonAvailability OnAvailabilityChanged, FName InGlobalId)
+{
+	if (!IsValid(InKey))
+	{
+		return;
+	}
+
+	const FSdAvailabilityKey		 AvailabilityKey = MakeAvailabilityKey(InKey, InGlobalId);
+	TSharedRef<FSdAvailabilityWatch> Watch = FindOrAddAvailabilityWatch(AvailabilityKey);
+	if (OnAvailabilityChanged.IsBound())
+	{
+		Watch->BlueprintEvents.AddUnique(OnAvailabilityChanged);
+	}
+
+	// a late subscriber is told right away, everyone else already knows
+	if (UObject* Current = Watch->Current.Get())
+	{
+		OnAvailabilityChanged.ExecuteIfBound(Current, true);
+		return;
+	}
+	FindAvailableSingleton(AvailabilityKey, Watch->KeyKind);
+}
+
+void USdSingletonSubsystem::UnwatchSingletonAvailability(UClass* InKey, FSdOnSingletonAvailability OnAvailabilityChanged, FName InGlobalId)
+{
+	if (TSharedRef<FSdAvailabilityWatch>* FoundWatch = AvailabilityWatches.Find(MakeAvailabilityKey(InKey, InGlobalId)))
+	{
+		(*FoundWatch)->BlueprintEvents.Remove(OnAvailabilityChanged);
+	}
+}
+
+FDelegateHandle USdSingletonSubsystem::AddSingletonAvailabilityHandler(const UClass* InKey, FSdOnSingletonAvailabilityNative::FDelegate&& InDelegate, FName InGlobalId)
+{
+	if (!IsValid(InKey))
+	{
+		return FDelegateHandle();
+	}
+
+	const FSdAvailabilityKey		 AvailabilityKey = MakeAvailabilityKey(InKey, InGlobalId);
+	TSharedRef<FSdAvailabilityWatch> Watch = FindOrAddAvailabilityWatch(AvailabilityKey);
+	FSdOnSingletonAvailabilityNative::FDelegate Delegate = MoveTemp(InDelegate);
+	FDelegateHandle								Handle = Watch->NativeEvent.Add(Delegate);
+
+	if (UObject* Current = Watch->Current.Get())
+	{
+		Delegate.ExecuteIfBound(Current, true);
+	}
+	else
+	{
+		FindAvailableSingleton(AvailabilityKey, Watch->KeyKind);
+	}
+	return Handle;
+}
+
+void USdSingletonSubsystem::RemoveSingletonAvailabilityHandler(const UClass* InKey, FDelegateHandle InHandle, FName InGlobalId)
+{
+	if (TSharedRef<FSdAvailabilityWatch>* FoundWatch = AvailabilityWatches.Find(MakeAvailabilityKey(InKey, InGlobalId)))
+	{
+		(*FoundWatch)->NativeEvent.Remove(InHandle);
+	}
+}
+
+bool USdSingletonSubsystem::IsSingletonAvailable(UClass* InKey, FName InGlobalId) const
+{
+	const TSharedRef<FSdAvailabilityWatch>* FoundWatch = AvailabilityWatches.Find(MakeAvailabilityKey(InKey, InGlobalId));
+	return FoundWatch && IsValid((*FoundWatch)->Current.Get());
+}
+
+void USdSingletonSubsystem::SetActorResolutionPolicy(TSubclassOf<AActor> InClass, ESdActorResolutionPolicy InPolicy)
+{
+	if (!IsValid(InClass))
+	{
+		return;
+	}
+	ActorResolutionIndex.SetPolicy(InClass, InPolicy);
+	SingletonActorCacheMap.Remove(InClass);
+	ActorCacheEntries.Remove(InClass);
+}
+
+void USdSingletonSubsystem::SetDefaultActorResolutionPolicy(ESdActorResolutionPolicy InPolicy)
+{
+	ActorResolutionIndex.SetDefaultPolicy(InPolicy);
+	SingletonActorCacheMap.Empty();
+	ActorCacheEntries.Empty();
+}
+
+void USdSingletonSubsystem::SetPreferredActorTag(FName InTag)
+{
+	ActorResolutionIndex.SetPreferredActorTag(InTag);
+	SingletonActorCacheMap.Empty();
+	ActorCacheEntries.Empty();
+}
 
 
 bool USdSingletonSubsystem::IsGlobalObjectInRegistry(TSubclassOf<UObject> InObjectClass, FName InGlobalId)
 {
 	FSdGlobalObjectHashKey ObjHashKey = FSdGlobalObjectHashKey(InObjectClass, InGlobalId);
-	return GlobalObjectRegistry.RegisteredObjects.Contains(ObjHashKey);
+	return GlobalObjectRegistry.Contains(ObjHashKey);
 }
 
 void USdSingletonSubsystem::RegisterGlobalObjectInRegistry(TSubclassOf<UObject> InObjectClass, UObject* InObject, FName InGlobalId)
 {
 	FSdGlobalObjectHashKey ObjHashKey = FSdGlobalObjectHashKey(InObjectClass, InGlobalId);
-	GlobalObjectRegistry.RegisteredObjects.Add(ObjHashKey, InObject);
+	GlobalObjectRegistry.Register(ObjHashKey, InObject);
+
+	// actor, component and interface keys are resolved by their lookups, only global object watches with the same ID
+	// hear about registrations
+	if (!IsValid(InObjectClass) || GetAvailabilityKeyKind(InObjectClass) != ESdAvailabilityKeyKind::GlobalObject)
+	{
+		return;
+	}
+
+	// registrations may come from the async loading thread or task graph workers, subscribers are always notified on the game thread
+	if (IsInGameThread())
+	{
+		NotifySingletonFound(FSdAvailabilityKey{ InObjectClass, InGlobalId }, InObject);
+	}
+	else if (bHasAvailabilityWatches)
+	{
+		TWeakObjectPtr<UClass>	WeakClass = InObjectClass.Get();
+		TWeakObjectPtr<UObject> WeakObject = InObject;
+		AsyncTask(ENamedThreads::GameThread, [WeakThis = TWeakObjectPtr<USdSingletonSubsystem>(this), WeakClass, WeakObject, InGlobalId]()
+			{
+				if (USdSingletonSubsystem* SingletonSubsystem = WeakThis.Get())
+				{
+					SingletonSubsystem->NotifySingletonFound(FSdAvailabilityKey{ WeakClass.Get(), InGlobalId }, WeakObject.Get());
+				}
+			});
+	}
 }
 
 UObject* USdSingletonSubsystem::K2_GetGlobalObjectInRegistry(TSubclassOf<UObject> InObjectClass, FName InGlobalId)
 {
 	FSdGlobalObjectHashKey ObjHashKey = FSdGlobalObjectHashKey(InObjectClass, InGlobalId);
-	if (GlobalObjectRegistry.RegisteredObjects.Contains(ObjHashKey))
+	return GlobalObjectRegistry.Find(ObjHashKey);
+}
+
+bool USdSingletonSubsystem::IsGlobalObjectInRegistrySoft(TSoftClassPtr<UObject> InObjectSoftClass, FName InGlobalId)
+{
+	// registrations are indexed by class path, so an unloaded class never needs to be loaded just to answer this
+	if (InObjectSoftClass.IsNull())
 	{
-		return GlobalObjectRegistry.RegisteredObjects[ObjHashKey];
+		return false;
 	}
-	return nullptr;
+
+	FSdGlobalObjectSoftHashKey SoftHashKey = FSdGlobalObjectSoftHashKey(InObjectSoftClass.ToSoftObjectPath(), InGlobalId);
+	return GlobalObjectRegistry.ContainsSoft(SoftHashKey);
 }
 
-bool USdSingletonSubsystem::IsGlobalObjectInRegistrySoft(TSoftClassPtr<UObject> InObjectSoftClass, FName InGlobalId)
-{	
-	if (InObjectSoftClass.Get() == nullptr)
+void USdSingletonSubsystem::RegisterGlobalObjectInRegistryAsync(TSoftClassPtr<UObject> InObjectSoftClass, UObject* InObject, FName InGlobalId, FSdOnGlobalObjectResolved OnRegistered)
+{
+	if (InObjectSoftClass.IsNull() || !IsValid(InObject))
 	{
-		UObject* LoadedObject = InObjectSoftClass.ToSoftObjectPath().TryLoad();
+		OnRegistered.ExecuteIfBound(nullptr);
+		return;
 	}
-	TSubclassOf<UObject> InObjectClass = InObjectSoftClass.Get();
 
-	FSdGlobalObjectHashKey ObjHashKey = FSdGlobalObjectHashKey(InObjectClass, InGlobalId);
-	return GlobalObjectRegistry.RegisteredObjects.Contains(ObjHashKey);
+	if (UClass* LoadedClass = InObjectSoftClass.Get())
+	{
+		RegisterGlobalObjectInRegistry(LoadedClass, InObject, InGlobalId);
+		OnRegistered.ExecuteIfBound(InObject);
+		return;
+	}
+
+	FSdGlobalObjectSoftHashKey SoftHashKey = FSdGlobalObjectSoftHashKey(InObjectSoftClass.ToSoftObjectPath(), InGlobalId);
+	PendingGlobalObjectRegistrations.FindOrAdd(SoftHashKey)++;
+
+	FStreamableDelegate OnClassLoaded = FStreamableDelegate::CreateUObject(this, &USdSingletonSubsystem::OnGlobalObjectClassLoaded, SoftHashKey, TWeakObjectPtr<UObject>(InObject), OnRegistered);
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftHashKey.ClassPath, OnClassLoaded);
+}
+
+void USdSingletonSubsystem::OnGlobalObjectClassLoaded(FSdGlobalObjectSoftHashKey SoftHashKey, TWeakObjectPtr<UObject> WeakObject, FSdOnGlobalObjectResolved OnRegistered)
+{
+	UObject* Object = WeakObject.Get();
+	UClass*	 LoadedClass = Cast<UClass>(SoftHashKey.ClassPath.ResolveObject());
+	if (IsValid(Object) && LoadedClass)
+	{
+		RegisterGlobalObjectInRegistry(LoadedClass, Object, SoftHashKey.GlobalId);
+	}
+	else
+	{
+		Object = nullptr;
+	}
+	OnRegistered.ExecuteIfBound(Object);
+
+	int32* PendingCount = PendingGlobalObjectRegistrations.Find(SoftHashKey);
+	if (PendingCount && --(*PendingCount) > 0)
+	{
+		return;
+	}
+	PendingGlobalObjectRegistrations.Remove(SoftHashKey);
+
+	TArray<FSdOnGlobalObjectResolved> WaitingQueries;
+	if (PendingGlobalObjectQueries.RemoveAndCopyValue(SoftHashKey, WaitingQueries))
+	{
+		UObject* RegisteredObject = LoadedClass ? K2_GetGlobalObjectInRegistry(LoadedClass, SoftHashKey.GlobalId) : nullptr;
+		for (const FSdOnGlobalObjectResolved& WaitingQuery : WaitingQueries)
+		{
+			WaitingQuery.ExecuteIfBound(RegisteredObject);
+		}
+	}
+}
+
+void USdSingletonSubsystem::GetGlobalObjectInRegistryAsync(TSoftClassPtr<UObject> InObjectSoftClass, FName InGlobalId, FSdOnGlobalObjectResolved OnResolved)
+{
+	if (InObjectSoftClass.IsNull())
+	{
+		OnResolved.ExecuteIfBound(nullptr);
+		return;
+	}
+
+	FSdGlobalObjectSoftHashKey SoftHashKey = FSdGlobalObjectSoftHashKey(InObjectSoftClass.ToSoftObjectPath(), InGlobalId);
+	if (PendingGlobalObjectRegistrations.Contains(SoftHashKey))
+	{
+		PendingGlobalObjectQueries.FindOrAdd(SoftHashKey).Add(OnResolved);
+		return;
+	}
+
+	// an unloaded class cannot have a registered instance, so there is nothing to stream in for a plain query
+	UClass* LoadedClass = InObjectSoftClass.Get();
+	OnResolved.ExecuteIfBound(LoadedClass ? K2_GetGlobalObjectInRegistry(LoadedClass, InGlobalId) : nullptr);
 }
 
 TMap<FString, UObject*> USdSingletonSubsystem::DebugGetObjectCacheSnapshot()
 {
 	TMap<FString, UObject*> OutCache;
 	
-	for (auto MapItx : GlobalObjectRegistry.RegisteredObjects)
-	{
-		OutCache.Add(MapItx.Key.GetHashKeyDisplayName(), MapItx.Value);
-	}
+	GlobalObjectRegistry.ForEach([&OutCache](const FSdGlobalObjectHashKey& HashKey, UObject* Object)
+		{
+			OutCache.Add(HashKey.GetHashKeyDisplayName(), Object);
+		});
 	return OutCache;
 }
 
 TMap<TSubclassOf<UObject>, AActor*> USdSingletonSubsystem::DebugGetActorCacheSnapshot()
 {
 	TMap<TSubclassOf<UObject>, AActor*> OutCache;
-	for (auto MapItx : SingletonActorCacheMap)
+	for (const auto& MapItx : SingletonActorCacheMap)
 	{
 		OutCache.Add(MapItx.Key, MapItx.Value);
 	}
@@ -372,9 +1174,170 @@ TMap<TSubclassOf<UObject>, AActor*> USdSingletonSubsystem::DebugGetActorCacheSna
 TMap<FSD_SingletonInterfaceHashKey, UObject*> USdSingletonSubsystem::DebugGetInterfaceCacheSnapshot()
 {
 	TMap<FSD_SingletonInterfaceHashKey, UObject*> OutCache;
-	for (auto MapItx : SingletonInterfaceCacheMap)
+	for (const auto& MapItx : SingletonInterfaceCacheMap)
 	{
 		OutCache.Add(MapItx.Key, MapItx.Value);
 	}
 	return OutCache;
-}
\ No newline at end of file
+}
+
+
+namespace SdSingletonSubsystem
+{
+	template <typename KeyType, typename ValueType>
+	FSdSingletonCacheStats MakeCacheMapStats(FName CacheName, const TMap<KeyType, ValueType>& CacheMap, const TMap<KeyType, FSdSingletonCacheEntry>& CacheEntries, uint64 Hits, uint64 Misses)
+	{
+		FSdSingletonCacheStats OutStats;
+		OutStats.CacheName = CacheName;
+		OutStats.NumEntries = CacheMap.Num();
+		OutStats.AllocatedBytes = CacheMap.GetAllocatedSize() + CacheEntries.GetAllocatedSize();
+		OutStats.Hits = Hits;
+		OutStats.Misses = Misses;
+		for (const auto& MapItx : CacheMap)
+		{
+			if (!IsValid(MapItx.Value))
+			{
+				OutStats.NumStaleEntries++;
+			}
+		}
+		return OutStats;
+	}
+} // namespace SdSingletonSubsystem
+
+TArray<FSdSingletonCacheStats> USdSingletonSubsystem::GetCacheStats() const
+{
+	TArray<FSdSingletonCacheStats> OutStats;
+
+	// derived classes, interface implementers and class depths are shared by every world, hits and misses are this world's
+	const FSdSingletonClassMetadata& ClassMetadata = FSdSingletonClassMetadata::Get();
+	FSdSingletonCacheStats&			 ClassMetadataStats = OutStats.AddDefaulted_GetRef();
+	ClassMetadataStats.CacheName = TEXT("ClassMetadata");
+	ClassMetadataStats.bSharedAcrossWorlds = true;
+	ClassMetadataStats.NumEntries = ClassMetadata.GetNumEntries();
+	ClassMetadataStats.AllocatedBytes = ClassMetadata.GetAllocatedSize();
+	ClassMetadataStats.Hits = DerivedClassCacheCounters.Hits;
+	ClassMetadataStats.Misses = DerivedClassCacheCounters.Misses;
+
+	FSdSingletonCacheStats& ActorStats = OutStats.Add_GetRef(SdSingletonSubsystem::MakeCacheMapStats(TEXT("Actors"), SingletonActorCacheMap, ActorCacheEntries, ActorCacheCounters.Hits, ActorCacheCounters.Misses));
+	ActorStats.AllocatedBytes += ActorResolutionIndex.GetAllocatedSize();
+	OutStats.Add(SdSingletonSubsystem::MakeCacheMapStats(TEXT("Components"), SingletonComponentCacheMap, ComponentCacheEntries, ComponentCacheCounters.Hits, ComponentCacheCounters.Misses));
+
+	FSdSingletonCacheStats& InterfaceStats = OutStats.Add_GetRef(SdSingletonSubsystem::MakeCacheMapStats(TEXT("Interfaces"), SingletonInterfaceCacheMap, InterfaceCacheEntries, InterfaceCacheCounters.Hits, InterfaceCacheCounters.Misses));
+	for (const auto& MapItx : SingletonInterfaceCacheMap)
+	{
+		InterfaceStats.AllocatedBytes += MapItx.Key.SingletonSearchParams.FilterString.GetAllocatedSize();
+	}
+	InterfaceStats.AllocatedBytes += InterfaceInstanceIndex.GetAllocatedSize();
+
+	const FSdGlobalObjectRegistry::FStats RegistryStats = GlobalObjectRegistry.GetStats();
+	FSdSingletonCacheStats&				  GlobalObjectStats = OutStats.AddDefaulted_GetRef();
+	GlobalObjectStats.CacheName = TEXT("GlobalObjects");
+	GlobalObjectStats.NumEntries = RegistryStats.NumEntries;
+	GlobalObjectStats.NumStaleEntries = RegistryStats.NumStaleEntries;
+	GlobalObjectStats.AllocatedBytes = RegistryStats.AllocatedBytes;
+	GlobalObjectStats.Hits = RegistryStats.Hits;
+	GlobalObjectStats.Misses = RegistryStats.Misses;
+
+	FSdSingletonCacheStats& LookupCostStats = OutStats.AddDefaulted_GetRef();
+	LookupCostStats.CacheName = TEXT("LookupCosts");
+	LookupCostStats.NumEntries = LookupStrategySelector.GetNumKeys();
+	LookupCostStats.AllocatedBytes = LookupStrategySelector.GetAllocatedSize();
+
+	return OutStats;
+}
+
+void USdSingletonSubsystem::ForEachCacheEntry(TFunctionRef<void(const FSdSingletonCacheEntryView&)> Visitor) const
+{
+	static const FName ActorsCacheName = TEXT("Actors");
+	static const FName ComponentsCacheName = TEXT("Components");
+	static const FName InterfacesCacheName = TEXT("Interfaces");
+	static const FName GlobalObjectsCacheName = TEXT("GlobalObjects");
+	static const FName DerivedClassesCacheName = TEXT("DerivedClasses");
+
+	for (const auto& MapItx : SingletonActorCacheMap)
+	{
+		Visitor(FSdSingletonCacheEntryView{ ActorsCacheName, MapItx.Key.Get(), nullptr, NAME_None, MapItx.Value, nullptr, ActorCacheEntries.Find(MapItx.Key) });
+	}
+	for (const auto& MapItx : SingletonComponentCacheMap)
+	{
+		Visitor(FSdSingletonCacheEntryView{ ComponentsCacheName, MapItx.Key.Get(), nullptr, NAME_None, MapItx.Value, nullptr, ComponentCacheEntries.Find(MapItx.Key) });
+	}
+	for (const auto& MapItx : SingletonInterfaceCacheMap)
+	{
+		Visitor(FSdSingletonCacheEntryView{ InterfacesCacheName, MapItx.Key.InterfaceClass.Get(), &MapItx.Key, NAME_None, MapItx.Value, nullptr, InterfaceCacheEntries.Find(MapItx.Key) });
+	}
+	GlobalObjectRegistry.ForEach([&Visitor](const FSdGlobalObjectHashKey& HashKey, UObject* RegisteredObject)
+		{
+			Visitor(FSdSingletonCacheEntryView{ GlobalObjectsCacheName, HashKey.ObjectClass.Get(), nullptr, HashKey.GlobalId, RegisteredObject, nullptr, nullptr });
+		});
+	FSdSingletonClassMetadata::Get().ForEachDerivedClassList([&Visitor](const UClass* BaseClass, const TArray<UClass*>& ChildClasses)
+		{
+			Visitor(FSdSingletonCacheEntryView{ DerivedClassesCacheName, BaseClass, nullptr, NAME_None, nullptr, &ChildClasses, nullptr });
+		});
+}
+
+void USdSingletonSubsystem::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	// surfaces the cache memory in memreport's "obj list" resource size columns
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	for (const FSdSingletonCacheStats& CacheStats : GetCacheStats())
+	{
+		// shared caches would be counted once per world
+		if (!CacheStats.bSharedAcrossWorlds)
+		{
+			CumulativeResourceSize.AddDedicatedSystemMemoryBytes(CacheStats.AllocatedBytes);
+		}
+	}
+}
+
+static void SdSingletonCacheReport(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	for (TObjectIterator<USdSingletonSubsystem> It; It; ++It)
+	{
+		const UWorld* SingletonWorld = It->GetWorld();
+		if (!SingletonWorld)
+		{
+			continue;
+		}
+
+		Ar.Logf(TEXT("SingletonUtil cache report for world %s"), *SingletonWorld->GetPathName());
+		Ar.Logf(TEXT("  %-16s %8s %8s %12s %12s %12s %8s"), TEXT("Cache"), TEXT("Entries"), TEXT("Stale"), TEXT("Bytes"), TEXT("Hits"), TEXT("Misses"), TEXT("HitRate"));
+
+		int64 TotalBytes = 0;
+		for (const FSdSingletonCacheStats& CacheStats : It->GetCacheStats())
+		{
+			Ar.Logf(TEXT("  %-16s %8d %8d %12lld %12lld %12lld %7.1f%%"), *CacheStats.CacheName.ToString(), CacheStats.NumEntries, CacheStats.NumStaleEntries, CacheStats.AllocatedBytes, CacheStats.Hits, CacheStats.Misses, CacheStats.GetHitRate() * 100.f);
+			TotalBytes += CacheStats.AllocatedBytes;
+		}
+		Ar.Logf(TEXT("  Total: %lld bytes"), TotalBytes);
+
+		Ar.Logf(TEXT("  Lookup costs per key (average ms / samples):"));
+		It->GetLookupStrategySelector().ForEachKeyCost([&Ar](const UClass* KeyClass, ESdLookupKind Kind, ESdLookupStrategy Strategy, float AverageMilliseconds, uint32 Samples)
+			{
+				static const TCHAR* KindNames[] = { TEXT("Actor"), TEXT("Component"), TEXT("Interface") };
+				Ar.Logf(TEXT("    %-10s %-40s %-16s %9.3f %8u"), KindNames[uint8(Kind)], *KeyClass->GetName(), *UEnum::GetDisplayValueAsText(Strategy).ToString(), AverageMilliseconds, Samples);
+			});
+	}
+}
+
+static FAutoConsoleCommandWithArgsAndOutputDevice SdSingletonCacheReportCommand(
+	TEXT("SingletonUtil.CacheReport"),
+	TEXT("Dumps entry counts, stale entries, allocated bytes and hit rates for every singleton cache in every world. Add it to [MemReportCommands] to include it in memreport."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&SdSingletonCacheReport));
+
+static void SdSingletonSavePrewarmProfiles(const TArray<FString>& Args, FOutputDevice& Ar)
+{
+	for (TObjectIterator<USdSingletonSubsystem> It; It; ++It)
+	{
+		const UWorld* SingletonWorld = It->GetWorld();
+		if (SingletonWorld && It->SavePrewarmProfile())
+		{
+			Ar.Logf(TEXT("SingletonUtil prewarm profile saved for map %s"), *FSdSingletonPrewarmProfile::GetProfileMapName(SingletonWorld));
+		}
+	}
+}
+
+static FAutoConsoleCommandWithArgsAndOutputDevice SdSingletonSavePrewarmProfilesCommand(
+	TEXT("SingletonUtil.Prewarm.Save"),
+	TEXT("Merges the singleton keys recorded since SingletonUtil.Prewarm.Record was set into each world's prewarm profile, without waiting for the world to be torn down."),
+	FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&SdSingletonSavePrewarmProfiles));
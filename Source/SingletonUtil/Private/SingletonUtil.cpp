@@ -2,12 +2,22 @@
 
 #include "SingletonUtil.h"
 
+#if WITH_GAMEPLAY_DEBUGGER
+#include "GameplayDebugger.h"
+#include "GameplayDebuggerCategory_SdSingleton.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "FSingletonUtilModule"
 
 void FSingletonUtilModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
 	
+#if WITH_GAMEPLAY_DEBUGGER
+	IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+	GameplayDebuggerModule.RegisterCategory("SingletonUtil", IGameplayDebugger::FOnGetCategory::CreateStatic(&FGameplayDebuggerCategory_SdSingleton::MakeInstance), EGameplayDebuggerCategoryState::Disabled);
+	GameplayDebuggerModule.NotifyCategoriesChanged();
+#endif
 }
 
 void FSingletonUtilModule::ShutdownModule()
@@ -15,6 +25,14 @@ void FSingletonUtilModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	
+#if WITH_GAMEPLAY_DEBUGGER
+	if (IGameplayDebugger::IsAvailable())
+	{
+		IGameplayDebugger& GameplayDebuggerModule = IGameplayDebugger::Get();
+		GameplayDebuggerModule.UnregisterCategory("SingletonUtil");
+		GameplayDebuggerModule.NotifyCategoriesChanged();
+	}
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -122,3 +122,31 @@ UActorComponent* USingletonUtilBPLibrary::K2_GetSingletonComponent(UObject* Worl
 	return nullptr;
 }
 
+
+void USingletonUtilBPLibrary::K2_WatchSingletonAvailability(UObject* WorldContextObject, UClass* Key, FSdOnSingletonAvailability OnAvailabilityChanged)
+{
+	if (!(WorldContextObject && IsValid(WorldContextObject)))
+	{
+		UE_LOG(LogSingletonUtilBPLibrary, Log, TEXT("USingletonUtilBPLibrary::WorldContextObject Is not valid"));
+		return;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	if (!(World && IsValid(World)))
+	{
+		UE_LOG(LogSingletonUtilBPLibrary, Log, TEXT("USingletonUtilBPLibrary::World Is not valid"));
+		return;
+	}
+
+	if (!(Key && IsValid(Key)))
+	{
+		UE_LOG(LogSingletonUtilBPLibrary, Log, TEXT("USingletonUtilBPLibrary::Class Is not valid"));
+		return;
+	}
+
+	USdSingletonSubsystem* SingletonSubsystem = UWorld::GetSubsystem<USdSingletonSubsystem>(World);
+	if (IsValid(SingletonSubsystem))
+	{
+		SingletonSubsystem->WatchSingletonAvailability(Key, OnAvailabilityChanged);
+	}
+}
@@ -0,0 +1,125 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdGlobalObjectRegistry.h"
+
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static TAutoConsoleVariable<int32> CVarSdRegistryTestOpsPerThread(
+	TEXT("SingletonUtil.Test.Registry.OpsPerThread"),
+	200000,
+	TEXT("Operations every worker thread runs in the SingletonUtil.Registry.Contention automation test"));
+
+// Contention test: 1 to 32 threads hammer one registry with a 90/10 read/write mix. Every key is only ever registered
+// with its own object, so any other result, or an object visible without its soft class path, is a torn update
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSdGlobalObjectRegistryContentionTest, "SingletonUtil.Registry.Contention", EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ApplicationContextMask)
+
+bool FSdGlobalObjectRegistryContentionTest::RunTest(const FString& Parameters)
+{
+	const int32 OpsPerThread = FMath::Max(1, CVarSdRegistryTestOpsPerThread.GetValueOnGameThread());
+	const int32 MaxThreads = 32;
+
+	// class default objects are rooted for the lifetime of their class, so they are safe to hand to worker threads.
+	// Soft keys are built up front, building one resolves a path name
+	TArray<FSdGlobalObjectHashKey>	   HashKeys;
+	TArray<FSdGlobalObjectSoftHashKey> SoftHashKeys;
+	TArray<UObject*>				   Objects;
+	for (TObjectIterator<UClass> It; It && HashKeys.Num() < 1024; ++It)
+	{
+		if (UObject* DefaultObject = It->GetDefaultObject(false))
+		{
+			HashKeys.Add(FSdGlobalObjectHashKey(*It));
+			SoftHashKeys.Add(FSdGlobalObjectSoftHashKey(HashKeys.Last()));
+			Objects.Add(DefaultObject);
+		}
+	}
+	if (!TestTrue(TEXT("Class default objects to register"), HashKeys.Num() > 0))
+	{
+		return false;
+	}
+
+	AddInfo(FString::Printf(TEXT("%d keys, %d shards, %d ops per thread, 90%% reads"), HashKeys.Num(), FSdGlobalObjectRegistry::NumShards, OpsPerThread));
+
+	for (int32 NumThreads = 1; NumThreads <= MaxThreads; NumThreads *= 2)
+	{
+		// half of the keys start registered, the writers add the rest while readers look them up
+		FSdGlobalObjectRegistry Registry;
+		for (int32 Index = 0; Index < HashKeys.Num(); Index += 2)
+		{
+			Registry.Register(HashKeys[Index], Objects[Index]);
+		}
+
+		std::atomic<uint64> NumWrongObjects{ 0 };
+		std::atomic<uint64> NumTornEntries{ 0 };
+		std::atomic<uint64> NumLostWrites{ 0 };
+
+		TArray<TFuture<void>> Workers;
+		const double		  StartSeconds = FPlatformTime::Seconds();
+		for (int32 ThreadIndex = 0; ThreadIndex < NumThreads; ++ThreadIndex)
+		{
+			Workers.Add(Async(EAsyncExecution::Thread, [&, ThreadIndex]()
+				{
+					FRandomStream Random(ThreadIndex + 1);
+					for (int32 Op = 0; Op < OpsPerThread; ++Op)
+					{
+						const int32 KeyIndex = Random.RandHelper(HashKeys.Num());
+						if (Random.RandHelper(10) == 0)
+						{
+							Registry.Register(HashKeys[KeyIndex], Objects[KeyIndex]);
+							if (Registry.Find(HashKeys[KeyIndex]) != Objects[KeyIndex] || !Registry.ContainsSoft(SoftHashKeys[KeyIndex]))
+							{
+								NumLostWrites.fetch_add(1, std::memory_order_relaxed);
+							}
+							continue;
+						}
+
+						// entries are never removed, so once the object is visible its class path must be as well
+						UObject*   FoundObject = Registry.Find(HashKeys[KeyIndex]);
+						const bool bSoftRegistered = Registry.ContainsSoft(SoftHashKeys[KeyIndex]);
+						if (FoundObject && FoundObject != Objects[KeyIndex])
+						{
+							NumWrongObjects.fetch_add(1, std::memory_order_relaxed);
+						}
+						if (FoundObject && !bSoftRegistered)
+						{
+							NumTornEntries.fetch_add(1, std::memory_order_relaxed);
+						}
+					}
+				}));
+		}
+		for (TFuture<void>& Worker : Workers)
+		{
+			Worker.Wait();
+		}
+		const double ElapsedSeconds = FMath::Max(FPlatformTime::Seconds() - StartSeconds, UE_SMALL_NUMBER);
+
+		const double TotalOps = double(OpsPerThread) * NumThreads;
+		AddInfo(FString::Printf(TEXT("%2d threads: %8.2f ms, %12.0f ops/s total, %12.0f ops/s per thread"), NumThreads, ElapsedSeconds * 1000.0, TotalOps / ElapsedSeconds, TotalOps / ElapsedSeconds / NumThreads));
+
+		TestEqual(*FString::Printf(TEXT("%d threads, lookups returning another key's object"), NumThreads), int64(NumWrongObjects.load()), int64(0));
+		TestEqual(*FString::Printf(TEXT("%d threads, objects visible without their class path"), NumThreads), int64(NumTornEntries.load()), int64(0));
+		TestEqual(*FString::Printf(TEXT("%d threads, registrations not visible to the registering thread"), NumThreads), int64(NumLostWrites.load()), int64(0));
+
+		// every entry that exists afterwards holds its own object, and its class path
+		int32 NumMismatchedEntries = 0;
+		for (int32 Index = 0; Index < HashKeys.Num(); ++Index)
+		{
+			UObject* FoundObject = Registry.Find(HashKeys[Index]);
+			if (FoundObject ? FoundObject != Objects[Index] || !Registry.ContainsSoft(SoftHashKeys[Index]) : Index % 2 == 0)
+			{
+				NumMismatchedEntries++;
+			}
+		}
+		TestEqual(*FString::Printf(TEXT("%d threads, mismatched entries after the run"), NumThreads), NumMismatchedEntries, 0);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
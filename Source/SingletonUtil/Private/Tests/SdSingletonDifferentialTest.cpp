@@ -0,0 +1,701 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+
+#include "SdSingletonSubsystem.h"
+#include "SdLookupStrategy.h"
+#include "SdSingletonPrewarmProfile.h"
+#include "SdSingletonDifferentialTestActors.h"
+
+#include "AI/Navigation/NavAgentInterface.h"
+#include "Components/SceneComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/TargetPoint.h"
+#include "Engine/World.h"
+#include "GameFramework/Info.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static TAutoConsoleVariable<int32> CVarSdDifferentialTestSteps(
+	TEXT("SingletonUtil.Test.Differential.Steps"),
+	2000,
+	TEXT("Number of randomized steps the SingletonUtil.Lookup.Differential automation test replays per lookup strategy"));
+
+static TAutoConsoleVariable<int32> CVarSdDifferentialTestSeed(
+	TEXT("SingletonUtil.Test.Differential.Seed"),
+	0,
+	TEXT("Random seed of the SingletonUtil.Lookup.Differential automation test, every run replays the same sequence for a given seed"));
+
+// Differential check of the optimized lookups (caches, resolution index, lookup strategies, registry shards) against
+// the original scans, over randomized spawn, destroy, stream and register sequences in a ticking synthetic world.
+// Streamed batches are real sublevels added to and removed from the world through level streaming. Any result that
+// differs from the reference fails the test.
+namespace SdSingletonDifferentialTest
+{
+	enum class ELookupKind : uint8
+	{
+		Actor,
+		Component,
+		Interface,
+		GlobalObject,
+		Num
+	};
+
+	static const TCHAR* LookupKindNames[] = { TEXT("Actor"), TEXT("Component"), TEXT("Interface"), TEXT("GlobalObject") };
+
+	static const TCHAR* WorldName = TEXT("SdSingletonDifferentialWorld");
+
+	static const FName PreferredActorTag = TEXT("Singleton");
+
+	constexpr float TickDeltaSeconds = 1.f / 60.f;
+
+	struct FLookupTally
+	{
+		uint64 Count = 0;
+		uint64 Wrong = 0;
+		double ReferenceSeconds = 0.0;
+		double OptimizedSeconds = 0.0;
+	};
+
+	struct FMismatch
+	{
+		int32		StrategyIndex = 0;
+		int32		Step = 0;
+		ELookupKind Kind = ELookupKind::Actor;
+		FString		Key;
+		FString		Expected;
+		FString		Actual;
+	};
+
+	struct FHarnessRun
+	{
+		UWorld*										  World = nullptr;
+		USdSingletonSubsystem*						  Subsystem = nullptr;
+		FRandomStream								  Random;
+		TArray<TWeakObjectPtr<AActor>>				  SpawnedActors;
+		TArray<TWeakObjectPtr<ULevelStreaming>>		  StreamedLevels;
+		TMap<FObjectKey, int32>						  SpawnOrder;
+		int32										  NextSpawnOrder = 0;
+		TMap<const UClass*, ESdActorResolutionPolicy> Policies;
+		TMap<TPair<const UClass*, FName>, UObject*>	  ReferenceRegistry;
+		FLookupTally								  Tallies[uint8(ELookupKind::Num)];
+	};
+
+	static TArray<UClass*> GetActorClasses()
+	{
+		return { AActor::StaticClass(), AInfo::StaticClass(), APawn::StaticClass(), AStaticMeshActor::StaticClass(), ATargetPoint::StaticClass(),
+			ASdDifferentialRootlessActorA::StaticClass(), ASdDifferentialRootlessActorB::StaticClass(), ASdDifferentialRootlessActorC::StaticClass(), ASdDifferentialRootlessActorD::StaticClass() };
+	}
+
+	static TArray<UClass*> GetRootlessActorClasses()
+	{
+		return { ASdDifferentialRootlessActorA::StaticClass(), ASdDifferentialRootlessActorB::StaticClass(), ASdDifferentialRootlessActorC::StaticClass(), ASdDifferentialRootlessActorD::StaticClass() };
+	}
+
+	static TArray<UClass*> GetComponentClasses()
+	{
+		return { USceneComponent::StaticClass(), UStaticMeshComponent::StaticClass() };
+	}
+
+	static const FName GlobalIds[] = { NAME_None, TEXT("A"), TEXT("B"), TEXT("C") };
+
+	static const TCHAR* InterfaceFilterStrings[] = { TEXT("Pawn"), TEXT("Controller"), TEXT("_1") };
+
+	static const ESdActorResolutionPolicy ResolutionPolicies[] = { ESdActorResolutionPolicy::HasRootComponent, ESdActorResolutionPolicy::DeepestDescendant, ESdActorResolutionPolicy::FirstSpawned, ESdActorResolutionPolicy::Tagged };
+
+	static AActor* SpawnTrackedActor(FHarnessRun& Run, UClass* Class, ULevel* InLevel = nullptr)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.OverrideLevel = InLevel;
+		AActor* Actor = Run.World->SpawnActor(Class, nullptr, SpawnParams);
+		if (Actor)
+		{
+			Run.SpawnedActors.Add(Actor);
+			Run.SpawnOrder.Add(FObjectKey(Actor), Run.NextSpawnOrder++);
+		}
+		return Actor;
+	}
+
+	static AActor* SpawnRandomActor(FHarnessRun& Run, ULevel* InLevel = nullptr)
+	{
+		const TArray<UClass*> ActorClasses = GetActorClasses();
+		AActor*				  Actor = SpawnTrackedActor(Run, ActorClasses[Run.Random.RandRange(0, ActorClasses.Num() - 1)], InLevel);
+		if (Actor && Run.Random.FRand() < 0.2f)
+		{
+			Actor->Tags.Add(PreferredActorTag);
+		}
+		return Actor;
+	}
+
+	static AActor* PickSpawnedActor(FHarnessRun& Run)
+	{
+		Run.SpawnedActors.RemoveAll([](const TWeakObjectPtr<AActor>& Actor) { return !Actor.IsValid(); });
+		return Run.SpawnedActors.Num() > 0 ? Run.SpawnedActors[Run.Random.RandRange(0, Run.SpawnedActors.Num() - 1)].Get() : nullptr;
+	}
+
+	// adds an empty in-memory level through a dynamic streaming level and fills it with a batch of actors
+	static void StreamInSublevel(FHarnessRun& Run, int32 BatchSize)
+	{
+		static int32 NextSublevelIndex = 0;
+		UPackage* LevelPackage = CreatePackage(*FString::Printf(TEXT("/Temp/SdSingletonDifferentialSublevel_%d"), NextSublevelIndex++));
+		UWorld*	  LevelWorld = UWorld::CreateWorld(EWorldType::Inactive, false, FName(FPackageName::GetShortName(LevelPackage)), LevelPackage, false, ERHIFeatureLevel::Num, nullptr, true);
+		if (!LevelWorld)
+		{
+			return;
+		}
+
+		ULevelStreamingDynamic* StreamingLevel = NewObject<ULevelStreamingDynamic>(Run.World, NAME_None, RF_Transient);
+		StreamingLevel->SetWorldAssetByPackageName(LevelPackage->GetFName());
+		StreamingLevel->SetShouldBeLoaded(true);
+		StreamingLevel->SetShouldBeVisible(true);
+		Run.World->AddStreamingLevel(StreamingLevel);
+		Run.World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+		ULevel* Level = StreamingLevel->GetLoadedLevel();
+		if (!Level || !Level->bIsVisible)
+		{
+			Run.World->RemoveStreamingLevel(StreamingLevel);
+			return;
+		}
+		Run.StreamedLevels.Add(StreamingLevel);
+
+		// the level's own actors, like its world settings, were there before anything the harness spawns
+		for (AActor* LevelActor : Level->Actors)
+		{
+			if (LevelActor)
+			{
+				Run.SpawnOrder.Add(FObjectKey(LevelActor), Run.NextSpawnOrder++);
+			}
+		}
+		for (int32 BatchIndex = 0; BatchIndex < BatchSize; ++BatchIndex)
+		{
+			SpawnRandomActor(Run, Level);
+		}
+	}
+
+	// unloads a streamed level the way streaming does, its actors are removed with the level rather than destroyed one by one
+	static void StreamOutSublevel(FHarnessRun& Run)
+	{
+		Run.StreamedLevels.RemoveAll([](const TWeakObjectPtr<ULevelStreaming>& StreamingLevel) { return !StreamingLevel.IsValid(); });
+		if (Run.StreamedLevels.Num() == 0)
+		{
+			return;
+		}
+
+		const int32		 LevelIndex = Run.Random.RandRange(0, Run.StreamedLevels.Num() - 1);
+		ULevelStreaming* StreamingLevel = Run.StreamedLevels[LevelIndex].Get();
+		Run.StreamedLevels.RemoveAtSwap(LevelIndex);
+
+		StreamingLevel->SetShouldBeVisible(false);
+		StreamingLevel->SetShouldBeLoaded(false);
+		Run.World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+		Run.World->RemoveStreamingLevel(StreamingLevel);
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	static void TickWorld(FHarnessRun& Run)
+	{
+		Run.World->Tick(LEVELTICK_All, TickDeltaSeconds);
+		FTSTicker::GetCoreTicker().Tick(TickDeltaSeconds);
+	}
+
+	// objects in a level belong to the world the level was added to, objects outside any level are global unless
+	// they report another world
+	static bool IsInWorldScope(const UObject* Object, const UWorld* World)
+	{
+		if (const ULevel* OuterLevel = Object->GetTypedOuter<ULevel>())
+		{
+			const UWorld* OwningWorld = OuterLevel->OwningWorld ? OuterLevel->OwningWorld.Get() : Object->GetWorld();
+			return OwningWorld == World;
+		}
+		if (Object->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+		{
+			return true;
+		}
+		const UWorld* ObjectWorld = Object->GetWorld();
+		return !ObjectWorld || ObjectWorld == World;
+	}
+
+	static int32 GetClassDepth(const UClass* Class)
+	{
+		int32 Depth = 0;
+		for (const UClass* SuperClass = Class->GetSuperClass(); SuperClass; SuperClass = SuperClass->GetSuperClass())
+		{
+			Depth++;
+		}
+		return Depth;
+	}
+
+	static int32 GetSpawnOrder(const FHarnessRun& Run, const AActor* Actor)
+	{
+		const int32* Order = Run.SpawnOrder.Find(FObjectKey(Actor));
+		return Order ? *Order : INDEX_NONE;
+	}
+
+	// the original lookup: the first actor with a root component, otherwise the last found of the deepest classes
+	static AActor* PickRootedOrDeepest(TConstArrayView<AActor*> Candidates)
+	{
+		AActor* BackupOption = nullptr;
+		for (AActor* Candidate : Candidates)
+		{
+			if (!BackupOption)
+			{
+				BackupOption = Candidate;
+			}
+			if (!IsValid(Candidate->GetRootComponent()))
+			{
+				if (Candidate->GetClass()->IsChildOf(BackupOption->GetClass()))
+				{
+					BackupOption = Candidate;
+				}
+				continue;
+			}
+			return Candidate;
+		}
+		return BackupOption;
+	}
+
+	// the original actor scan ranked by the class's policy, without the resolution index or the lookup strategies
+	static UObject* ReferenceActor(FHarnessRun& Run, UClass* Class)
+	{
+		TArray<AActor*> Candidates;
+		UGameplayStatics::GetAllActorsOfClass(Run.World, Class, Candidates);
+
+		const ESdActorResolutionPolicy* PolicyOverride = Run.Policies.Find(Class);
+		const ESdActorResolutionPolicy	Policy = PolicyOverride ? *PolicyOverride : ESdActorResolutionPolicy::HasRootComponent;
+		switch (Policy)
+		{
+			case ESdActorResolutionPolicy::DeepestDescendant:
+			{
+				AActor* BestActor = nullptr;
+				for (AActor* Candidate : Candidates)
+				{
+					if (!BestActor)
+					{
+						BestActor = Candidate;
+						continue;
+					}
+					const int32 CandidateDepth = GetClassDepth(Candidate->GetClass());
+					const int32 BestDepth = GetClassDepth(BestActor->GetClass());
+					const bool	bCandidateRooted = IsValid(Candidate->GetRootComponent());
+					const bool	bBestRooted = IsValid(BestActor->GetRootComponent());
+					if (CandidateDepth != BestDepth ? CandidateDepth > BestDepth : bCandidateRooted != bBestRooted ? bCandidateRooted : GetSpawnOrder(Run, Candidate) < GetSpawnOrder(Run, BestActor))
+					{
+						BestActor = Candidate;
+					}
+				}
+				return BestActor;
+			}
+			case ESdActorResolutionPolicy::FirstSpawned:
+			{
+				AActor* BestActor = nullptr;
+				for (AActor* Candidate : Candidates)
+				{
+					if (!BestActor || GetSpawnOrder(Run, Candidate) < GetSpawnOrder(Run, BestActor))
+					{
+						BestActor = Candidate;
+					}
+				}
+				return BestActor;
+			}
+			case ESdActorResolutionPolicy::Tagged:
+			{
+				const TArray<AActor*> TaggedCandidates = Candidates.FilterByPredicate([](const AActor* Candidate) { return Candidate->ActorHasTag(PreferredActorTag); });
+				return PickRootedOrDeepest(TaggedCandidates.Num() > 0 ? TaggedCandidates : Candidates);
+			}
+			case ESdActorResolutionPolicy::HasRootComponent:
+			default:
+				return PickRootedOrDeepest(Candidates);
+		}
+	}
+
+	// the original component lookup: the first component of the class on the first actor that has one
+	static UObject* ReferenceComponent(FHarnessRun& Run, UClass* Class)
+	{
+		TArray<AActor*> WorldActors;
+		UGameplayStatics::GetAllActorsOfClass(Run.World, AActor::StaticClass(), WorldActors);
+		for (AActor* ActorRef : WorldActors)
+		{
+			UActorComponent* ActorComp = ActorRef->GetComponentByClass(Class);
+			if (ActorComp && IsValid(ActorComp))
+			{
+				return ActorComp;
+			}
+		}
+		return nullptr;
+	}
+
+	// the original interface lookup, limited to the objects in the world's scope like every per-world lookup
+	static UObject* ReferenceInterface(FHarnessRun& Run, UClass* InterfaceClass, const FSD_SingletonSearchParams& SearchParams)
+	{
+		if (SearchParams.bIncludeOnlyActors)
+		{
+			TArray<AActor*> WorldActors;
+			UGameplayStatics::GetAllActorsWithInterface(Run.World, InterfaceClass, WorldActors);
+			return WorldActors.Num() > 0 ? WorldActors[0] : nullptr;
+		}
+
+		for (FThreadSafeObjectIterator It; It; ++It)
+		{
+			if (!It->GetClass()->ImplementsInterface(InterfaceClass))
+			{
+				continue;
+			}
+
+			if (It->IsTemplate(RF_ClassDefaultObject))
+			{
+				if (!SearchParams.bShouldIncludeDefaultObjects)
+				{
+					continue;
+				}
+			}
+			else if (SearchParams.bOnlyDefaultObjects)
+			{
+				continue;
+			}
+
+			if (SearchParams.bOnlyGCObjects && GUObjectArray.IsDisregardForGC(*It))
+			{
+				continue;
+			}
+
+			if (SearchParams.bOnlyRootObjects && !It->IsRooted())
+			{
+				continue;
+			}
+
+			if (SearchParams.FilterClass && !It->IsA(SearchParams.FilterClass))
+			{
+				continue;
+			}
+
+			if (!SearchParams.FilterString.IsEmpty() && !It->GetName().Contains(SearchParams.FilterString))
+			{
+				continue;
+			}
+
+			if (!SearchParams.bIncludeTransient)
+			{
+				UPackage* ContainerPackage = It->GetOutermost();
+				if (ContainerPackage == GetTransientPackage() || ContainerPackage->HasAnyFlags(RF_Transient))
+				{
+					continue;
+				}
+			}
+
+			if (!IsInWorldScope(*It, Run.World))
+			{
+				continue;
+			}
+
+			return *It;
+		}
+		return nullptr;
+	}
+
+	static void CompareLookup(FHarnessRun& Run, TArray<FMismatch>& Mismatches, int32 StrategyIndex, int32 Step, ELookupKind Kind, const FString& Key,
+		TFunctionRef<UObject*()> Optimized, TFunctionRef<UObject*()> Reference)
+	{
+		FLookupTally& Tally = Run.Tallies[uint8(Kind)];
+
+		const double OptimizedStartSeconds = FPlatformTime::Seconds();
+		UObject*	 Actual = Optimized();
+		Tally.OptimizedSeconds += FPlatformTime::Seconds() - OptimizedStartSeconds;
+
+		const double ReferenceStartSeconds = FPlatformTime::Seconds();
+		UObject*	 Expected = Reference();
+		Tally.ReferenceSeconds += FPlatformTime::Seconds() - ReferenceStartSeconds;
+
+		Tally.Count++;
+		if (Actual == Expected)
+		{
+			return;
+		}
+		Tally.Wrong++;
+
+		FMismatch& Mismatch = Mismatches.AddDefaulted_GetRef();
+		Mismatch.StrategyIndex = StrategyIndex;
+		Mismatch.Step = Step;
+		Mismatch.Kind = Kind;
+		Mismatch.Key = Key;
+		Mismatch.Expected = GetNameSafe(Expected);
+		Mismatch.Actual = GetNameSafe(Actual);
+	}
+
+	static void CompareActorLookup(FHarnessRun& Run, TArray<FMismatch>& Mismatches, int32 StrategyIndex, int32 Step, UClass* Class)
+	{
+		CompareLookup(Run, Mismatches, StrategyIndex, Step, ELookupKind::Actor, Class->GetName(),
+			[&Run, Class]() { return Run.Subsystem->K2_GetSingletonActor(Class, false, false); },
+			[&Run, Class]() { return ReferenceActor(Run, Class); });
+	}
+
+	// mostly the default search, otherwise one non-default param at a time, each is cached under its own key
+	static FSD_SingletonSearchParams MakeRandomSearchParams(FHarnessRun& Run)
+	{
+		FSD_SingletonSearchParams SearchParams;
+		switch (Run.Random.RandRange(0, 5))
+		{
+			case 3:
+				SearchParams.FilterString = InterfaceFilterStrings[Run.Random.RandRange(0, UE_ARRAY_COUNT(InterfaceFilterStrings) - 1)];
+				break;
+			case 4:
+				SearchParams.bIncludeTransient = true;
+				break;
+			case 5:
+				SearchParams.bIncludeOnlyActors = true;
+				break;
+			default:
+				break;
+		}
+		return SearchParams;
+	}
+
+	static FString DescribeSearchParams(const FSD_SingletonSearchParams& SearchParams)
+	{
+		if (SearchParams.bIncludeOnlyActors)
+		{
+			return TEXT(" (only actors)");
+		}
+		if (SearchParams.bIncludeTransient)
+		{
+			return TEXT(" (transient)");
+		}
+		return SearchParams.FilterString.IsEmpty() ? FString() : FString::Printf(TEXT(" (filter %s)"), *SearchParams.FilterString);
+	}
+
+	// The original lookup keeps the first rootless actor unless a later one derives from its class, so siblings resolve
+	// by spawn order: B then C keeps B, C then D keeps C. Every class is looked up after each spawn, so cached answers
+	// and the resolution index have to follow the actors spawned after them
+	static void RunRootlessSiblingScenarios(FHarnessRun& Run, TArray<FMismatch>& Mismatches, int32 StrategyIndex)
+	{
+		const TArray<UClass*> RootlessClasses = GetRootlessActorClasses();
+		const TArray<UClass*> SpawnSequences[] = {
+			{ ASdDifferentialRootlessActorB::StaticClass(), ASdDifferentialRootlessActorC::StaticClass() },
+			{ ASdDifferentialRootlessActorC::StaticClass(), ASdDifferentialRootlessActorD::StaticClass() },
+		};
+		for (const TArray<UClass*>& SpawnSequence : SpawnSequences)
+		{
+			TArray<AActor*> ScenarioActors;
+			for (UClass* SpawnClass : SpawnSequence)
+			{
+				ScenarioActors.Add(SpawnTrackedActor(Run, SpawnClass));
+				for (UClass* LookupClass : RootlessClasses)
+				{
+					CompareActorLookup(Run, Mismatches, StrategyIndex, INDEX_NONE, LookupClass);
+				}
+			}
+			for (AActor* Actor : ScenarioActors)
+			{
+				if (Actor)
+				{
+					Actor->Destroy();
+				}
+			}
+			TickWorld(Run);
+		}
+	}
+
+	static void RunStep(FHarnessRun& Run, TArray<FMismatch>& Mismatches, int32 StrategyIndex, int32 Step)
+	{
+		const TArray<UClass*> ActorClasses = GetActorClasses();
+		const TArray<UClass*> ComponentClasses = GetComponentClasses();
+
+		const float Roll = Run.Random.FRand();
+		if (Roll < 0.25f)
+		{
+			SpawnRandomActor(Run);
+		}
+		else if (Roll < 0.37f)
+		{
+			if (AActor* Actor = PickSpawnedActor(Run))
+			{
+				Actor->Destroy();
+			}
+		}
+		else if (Roll < 0.45f)
+		{
+			if (AActor* Actor = PickSpawnedActor(Run))
+			{
+				Actor->AddComponentByClass(ComponentClasses[Run.Random.RandRange(0, ComponentClasses.Num() - 1)], false, FTransform::Identity, false);
+			}
+		}
+		else if (Roll < 0.50f)
+		{
+			if (Run.Random.FRand() < 0.5f)
+			{
+				StreamInSublevel(Run, Run.Random.RandRange(3, 8));
+			}
+			else
+			{
+				StreamOutSublevel(Run);
+			}
+		}
+		else if (Roll < 0.58f)
+		{
+			UClass*		Class = ActorClasses[Run.Random.RandRange(0, ActorClasses.Num() - 1)];
+			const FName GlobalId = GlobalIds[Run.Random.RandRange(0, UE_ARRAY_COUNT(GlobalIds) - 1)];
+			UObject*	Object = PickSpawnedActor(Run);
+			Run.Subsystem->RegisterGlobalObjectInRegistry(Class, Object, GlobalId);
+			Run.ReferenceRegistry.Add(TPair<const UClass*, FName>(Class, GlobalId), Object);
+		}
+		else if (Roll < 0.60f)
+		{
+			UClass*						   Class = ActorClasses[Run.Random.RandRange(0, ActorClasses.Num() - 1)];
+			const ESdActorResolutionPolicy Policy = ResolutionPolicies[Run.Random.RandRange(0, UE_ARRAY_COUNT(ResolutionPolicies) - 1)];
+			Run.Subsystem->SetActorResolutionPolicy(Class, Policy);
+			Run.Policies.Add(Class, Policy);
+		}
+		else if (Roll < 0.75f)
+		{
+			CompareActorLookup(Run, Mismatches, StrategyIndex, Step, ActorClasses[Run.Random.RandRange(0, ActorClasses.Num() - 1)]);
+		}
+		else if (Roll < 0.87f)
+		{
+			UClass* Class = ComponentClasses[Run.Random.RandRange(0, ComponentClasses.Num() - 1)];
+			CompareLookup(Run, Mismatches, StrategyIndex, Step, ELookupKind::Component, Class->GetName(),
+				[&Run, Class]() { return Run.Subsystem->K2_GetSingletonComponent(Class, false); },
+				[&Run, Class]() { return ReferenceComponent(Run, Class); });
+		}
+		else if (Roll < 0.93f)
+		{
+			UClass*							InterfaceClass = UNavAgentInterface::StaticClass();
+			const FSD_SingletonSearchParams SearchParams = MakeRandomSearchParams(Run);
+			CompareLookup(Run, Mismatches, StrategyIndex, Step, ELookupKind::Interface, InterfaceClass->GetName() + DescribeSearchParams(SearchParams),
+				[&Run, InterfaceClass, &SearchParams]()
+				{
+					UObject* FoundObject = nullptr;
+					Run.Subsystem->K2_GetSingletonInterface(InterfaceClass, FoundObject, SearchParams, false);
+					return FoundObject;
+				},
+				[&Run, InterfaceClass, &SearchParams]() { return ReferenceInterface(Run, InterfaceClass, SearchParams); });
+		}
+		else
+		{
+			UClass*		Class = ActorClasses[Run.Random.RandRange(0, ActorClasses.Num() - 1)];
+			const FName GlobalId = GlobalIds[Run.Random.RandRange(0, UE_ARRAY_COUNT(GlobalIds) - 1)];
+			CompareLookup(Run, Mismatches, StrategyIndex, Step, ELookupKind::GlobalObject, FString::Printf(TEXT("%s/%s"), *Class->GetName(), *GlobalId.ToString()),
+				[&Run, Class, GlobalId]() { return Run.Subsystem->K2_GetGlobalObjectInRegistry(Class, GlobalId); },
+				[&Run, Class, GlobalId]()
+				{
+					UObject* const* Registered = Run.ReferenceRegistry.Find(TPair<const UClass*, FName>(Class, GlobalId));
+					return Registered ? *Registered : nullptr;
+				});
+		}
+	}
+
+	static void DeletePrewarmProfile()
+	{
+		IFileManager::Get().Delete(*FSdSingletonPrewarmProfile::GetProfilePath(WorldName, false), false, false, true);
+	}
+} // namespace SdSingletonDifferentialTest
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSdSingletonDifferentialTest, "SingletonUtil.Lookup.Differential", EAutomationTestFlags::EngineFilter | EAutomationTestFlags::ApplicationContextMask)
+
+bool FSdSingletonDifferentialTest::RunTest(const FString& Parameters)
+{
+	using namespace SdSingletonDifferentialTest;
+
+	const int32 NumSteps = FMath::Max(1, CVarSdDifferentialTestSteps.GetValueOnGameThread());
+	const int32 Seed = CVarSdDifferentialTestSeed.GetValueOnGameThread();
+	const int32 MaxListedMismatches = 20;
+
+	IConsoleVariable* ForceStrategyVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("SingletonUtil.Lookup.ForceStrategy"));
+	IConsoleVariable* PrewarmRecordVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("SingletonUtil.Prewarm.Record"));
+	if (!TestNotNull(TEXT("SingletonUtil.Lookup.ForceStrategy"), ForceStrategyVariable) || !TestNotNull(TEXT("SingletonUtil.Prewarm.Record"), PrewarmRecordVariable))
+	{
+		return false;
+	}
+	const int32 PreviousForcedStrategy = ForceStrategyVariable->GetInt();
+	const bool	bPreviousPrewarmRecord = PrewarmRecordVariable->GetBool();
+
+	// the first strategy records the prewarm profile of the synthetic map, the following ones prewarm from it
+	DeletePrewarmProfile();
+	PrewarmRecordVariable->Set(true, ECVF_SetByConsole);
+
+	AddInfo(FString::Printf(TEXT("%d steps per strategy, seed %d"), NumSteps, Seed));
+	AddInfo(FString::Printf(TEXT("%-16s %-13s %8s %6s %10s %10s %8s"), TEXT("Strategy"), TEXT("Lookup"), TEXT("Count"), TEXT("Wrong"), TEXT("RefMs"), TEXT("OptMs"), TEXT("Speedup")));
+
+	TArray<FMismatch> Mismatches;
+	uint64			  TotalWrong = 0;
+	for (int32 StrategyIndex = 0; StrategyIndex < int32(ESdLookupStrategy::MAX); ++StrategyIndex)
+	{
+		ForceStrategyVariable->Set(StrategyIndex, ECVF_SetByConsole);
+
+		// every strategy replays the same sequence in its own synthetic world
+		FHarnessRun Run;
+		Run.Random.Initialize(Seed);
+		// the package name is the prewarm profile's map name, so it is the same for every strategy
+		UPackage* WorldPackage = CreatePackage(*FString::Printf(TEXT("/Temp/%s"), WorldName));
+		Run.World = UWorld::CreateWorld(EWorldType::Game, false, MakeUniqueObjectName(WorldPackage, UWorld::StaticClass(), WorldName), WorldPackage);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(Run.World);
+
+		Run.World->InitializeActorsForPlay(FURL());
+		Run.World->BeginPlay();
+		if (AWorldSettings* WorldSettings = Run.World->GetWorldSettings())
+		{
+			WorldSettings->NotifyBeginPlay();
+		}
+		Run.Subsystem = Run.World->GetSubsystem<USdSingletonSubsystem>();
+
+		if (TestNotNull(TEXT("Singleton subsystem"), Run.Subsystem))
+		{
+			RunRootlessSiblingScenarios(Run, Mismatches, StrategyIndex);
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				RunStep(Run, Mismatches, StrategyIndex, Step);
+				TickWorld(Run);
+			}
+		}
+
+		const FString StrategyName = StaticEnum<ESdLookupStrategy>()->GetNameStringByValue(StrategyIndex);
+		for (uint8 KindIndex = 0; KindIndex < uint8(ELookupKind::Num); ++KindIndex)
+		{
+			const FLookupTally& Tally = Run.Tallies[KindIndex];
+			const double		Speedup = Tally.OptimizedSeconds > 0.0 ? Tally.ReferenceSeconds / Tally.OptimizedSeconds : 0.0;
+			AddInfo(FString::Printf(TEXT("%-16s %-13s %8llu %6llu %10.3f %10.3f %7.1fx"), *StrategyName, LookupKindNames[KindIndex], Tally.Count, Tally.Wrong,
+				Tally.ReferenceSeconds * 1000.0, Tally.OptimizedSeconds * 1000.0, Speedup));
+			TotalWrong += Tally.Wrong;
+		}
+
+		GEngine->DestroyWorldContext(Run.World);
+		Run.World->DestroyWorld(false);
+		Run.World->RemoveFromRoot();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	ForceStrategyVariable->Set(PreviousForcedStrategy, ECVF_SetByConsole);
+	PrewarmRecordVariable->Set(bPreviousPrewarmRecord, ECVF_SetByConsole);
+	DeletePrewarmProfile();
+
+	// every result that differs from the reference is wrong, only the first ones are listed
+	for (int32 MismatchIndex = 0; MismatchIndex < FMath::Min(Mismatches.Num(), MaxListedMismatches); ++MismatchIndex)
+	{
+		const FMismatch& Mismatch = Mismatches[MismatchIndex];
+		const FString	 StepName = Mismatch.Step == INDEX_NONE ? FString(TEXT("rootless siblings")) : FString::Printf(TEXT("step %d"), Mismatch.Step);
+		AddError(FString::Printf(TEXT("%s %s, %s %s: expected %s, got %s"), *StaticEnum<ESdLookupStrategy>()->GetNameStringByValue(Mismatch.StrategyIndex), *StepName,
+			LookupKindNames[uint8(Mismatch.Kind)], *Mismatch.Key, *Mismatch.Expected, *Mismatch.Actual));
+	}
+	if (Mismatches.Num() > MaxListedMismatches)
+	{
+		AddError(FString::Printf(TEXT("%d more mismatches not listed"), Mismatches.Num() - MaxListedMismatches));
+	}
+	AddInfo(FString::Printf(TEXT("%llu wrong"), TotalWrong));
+
+	return TotalWrong == 0;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
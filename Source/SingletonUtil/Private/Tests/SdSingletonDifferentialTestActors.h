@@ -0,0 +1,34 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SdSingletonDifferentialTestActors.generated.h"
+
+// Rootless actor classes of the SingletonUtil.Lookup.Differential automation test. B and C are siblings under A, and D
+// derives from B, so the original lookup's rootless backup depends on which of them spawned first
+
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown)
+class ASdDifferentialRootlessActorA : public AActor
+{
+	GENERATED_BODY()
+};
+
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown)
+class ASdDifferentialRootlessActorB : public ASdDifferentialRootlessActorA
+{
+	GENERATED_BODY()
+};
+
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown)
+class ASdDifferentialRootlessActorC : public ASdDifferentialRootlessActorA
+{
+	GENERATED_BODY()
+};
+
+UCLASS(NotBlueprintable, NotPlaceable, HideDropdown)
+class ASdDifferentialRootlessActorD : public ASdDifferentialRootlessActorB
+{
+	GENERATED_BODY()
+};
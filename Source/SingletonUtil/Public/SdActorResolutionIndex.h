@@ -0,0 +1,99 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "SdActorResolutionIndex.generated.h"
+
+class AActor;
+
+/** How a singleton actor is chosen when several actors of the requested class exist */
+UENUM(BlueprintType)
+enum class ESdActorResolutionPolicy : uint8
+{
+	// First actor with a valid root component. Otherwise the first actor found, replaced by every later one of the same or
+	// a derived class. Default, matches the original lookup
+	HasRootComponent,
+	// Deepest class in the hierarchy, then actors with a root component, then the earliest spawned
+	DeepestDescendant,
+	// Earliest spawned actor
+	FirstSpawned,
+	// Actors carrying the preferred actor tag first, then the HasRootComponent order. Tags are read on every lookup
+	Tagged,
+};
+
+/**
+ * Per-class ranking of singleton actor candidates for one world. Class depths come from the process-wide FSdSingletonClassMetadata.
+ * Every requested class keeps its preferred candidate. Spawned actors are offered once to the classes in their hierarchy
+ * that are being tracked, after every actor already known, so the preferred instance is known without iterating
+ * candidates on lookup. Classes using the Tagged policy keep all of their candidates in the order they were found
+ * instead and pick on lookup, since tags can change after spawn. Actors of streamed levels are never offered, the owner
+ * invalidates their classes when a level is added or removed.
+ */
+class SINGLETONUTIL_API FSdActorResolutionIndex
+{
+public:
+	// Returns the tracked preferred actor for the class, nullptr if the class is untracked or its candidate is gone
+	AActor* FindPreferredActor(const UClass* InClass);
+
+	// Ranks a full candidate list in a single pass, starts tracking the class and returns its preferred actor
+	AActor* ResolveFromCandidates(const UClass* InClass, TConstArrayView<AActor*> Candidates);
+
+	// Offers a newly spawned actor to every tracked class in its hierarchy
+	void OnActorSpawned(AActor* InActor);
+
+	// Stops tracking the actor class and every class above it, their next lookup scans again
+	void InvalidateActorClass(const UClass* InActorClass);
+
+	ESdActorResolutionPolicy GetPolicy(const UClass* InClass) const;
+
+	void SetPolicy(const UClass* InClass, ESdActorResolutionPolicy InPolicy);
+
+	void SetDefaultPolicy(ESdActorResolutionPolicy InPolicy);
+
+	void SetPreferredActorTag(FName InTag);
+
+	// Drops all tracked candidates, policies are kept
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FCandidate
+	{
+		TWeakObjectPtr<AActor> Actor;
+		uint64				   Rank = 0;
+	};
+
+	struct FTrackedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		uint64				   Serial = 0;
+	};
+
+	// Higher is better, only used by the DeepestDescendant and FirstSpawned policies. Serial is the spawn order, lower means earlier
+	uint64 RankActor(const AActor* InActor, ESdActorResolutionPolicy InPolicy, uint64 InSerial) const;
+
+	// Whether InActor, found after the current candidate, takes its place
+	bool ReplacesCandidate(const FCandidate& InCandidate, const AActor* InActor, ESdActorResolutionPolicy InPolicy, uint64 InSerial) const;
+
+	void SetCandidate(FCandidate& OutCandidate, AActor* InActor, ESdActorResolutionPolicy InPolicy, uint64 InSerial) const;
+
+	// Keys hold no strong reference, a collected class simply stops matching
+	TMap<TObjectKey<UClass>, FCandidate> PreferredActors;
+
+	// Every live candidate of the tracked classes using the Tagged policy, in the order they were found
+	TMap<TObjectKey<UClass>, TArray<FTrackedActor>> TaggedCandidates;
+
+	TMap<TObjectKey<UClass>, ESdActorResolutionPolicy> PolicyOverrides;
+
+	ESdActorResolutionPolicy DefaultPolicy = ESdActorResolutionPolicy::HasRootComponent;
+
+	FName PreferredActorTag = TEXT("Singleton");
+
+	// actors found by a scan use their iteration order, actors spawned afterwards always count as later
+	uint64 NextSpawnSerial = uint64(1) << 32;
+};
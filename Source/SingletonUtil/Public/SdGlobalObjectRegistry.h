@@ -0,0 +1,193 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+#include "Templates/SubclassOf.h"
+#include "UObject/Object.h"
+#include "UObject/SoftObjectPath.h"
+#include "SdGlobalObjectRegistry.generated.h"
+
+
+USTRUCT(BlueprintType)
+struct FSdGlobalObjectHashKey
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FSdGlobalObjectHashKey() {}
+	FSdGlobalObjectHashKey(TSubclassOf<UObject> InObjectClass)
+	{
+		ObjectClass = InObjectClass;
+	}
+
+	FSdGlobalObjectHashKey(TSubclassOf<UObject> InObjectClass, FName InGlobalId)
+	{
+		ObjectClass = InObjectClass;
+		GlobalId = InGlobalId;
+	}
+
+	UPROPERTY()
+	TSubclassOf<UObject> ObjectClass = UObject::StaticClass();
+
+	UPROPERTY()
+	FName GlobalId = NAME_None;
+
+	friend bool operator==(const FSdGlobalObjectHashKey& A, const FSdGlobalObjectHashKey& B)
+	{
+		return A.ObjectClass == B.ObjectClass && A.GlobalId == B.GlobalId;
+	}
+
+	friend uint32 GetTypeHash(const FSdGlobalObjectHashKey& Key)
+	{
+		const uint32 StartLocationHash = GetTypeHash(Key.ObjectClass);
+		const uint32 EndLocationHash = GetTypeHash(Key.GlobalId);
+		return HashCombine(StartLocationHash, EndLocationHash);
+	}
+
+	FString GetHashKeyDisplayName() const
+	{
+		FString OutDisplayName;
+		ObjectClass->GetName(OutDisplayName);
+		if (GlobalId != NAME_None)
+		{
+			OutDisplayName = OutDisplayName.Append(TEXT("_"));
+			OutDisplayName = OutDisplayName.Append(GlobalId.ToString());
+		}
+		return OutDisplayName;
+	}
+};
+
+USTRUCT(BlueprintType)
+struct FSdGlobalObjectSoftHashKey
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	FSdGlobalObjectSoftHashKey() {}
+	FSdGlobalObjectSoftHashKey(const FSoftObjectPath& InClassPath, FName InGlobalId = NAME_None)
+	{
+		ClassPath = InClassPath;
+		GlobalId = InGlobalId;
+	}
+
+	// Builds the soft key for an already loaded class, so registration and soft queries share one key space
+	FSdGlobalObjectSoftHashKey(const FSdGlobalObjectHashKey& InHashKey)
+	{
+		ClassPath = FSoftObjectPath(InHashKey.ObjectClass.Get());
+		GlobalId = InHashKey.GlobalId;
+	}
+
+	UPROPERTY()
+	FSoftObjectPath ClassPath;
+
+	UPROPERTY()
+	FName GlobalId = NAME_None;
+
+	friend bool operator==(const FSdGlobalObjectSoftHashKey& A, const FSdGlobalObjectSoftHashKey& B)
+	{
+		return A.ClassPath == B.ClassPath && A.GlobalId == B.GlobalId;
+	}
+
+	friend uint32 GetTypeHash(const FSdGlobalObjectSoftHashKey& Key)
+	{
+		return HashCombine(GetTypeHash(Key.ClassPath), GetTypeHash(Key.GlobalId));
+	}
+};
+
+/**
+ * Concurrent registry of global UObjects.
+ * Entries are spread over a fixed number of shards, each guarded by its own read-write lock, so lookups from
+ * task graph jobs and registrations from the async loading thread only contend when they land on the same shard.
+ * Shards are picked by class name and global id, so an entry and its soft class path always share a shard and are
+ * updated under the same lock.
+ * Replaces the FSdGlobalObjectRegistry USTRUCT, whose RegisteredObjects map is now private to the shards.
+ */
+class SINGLETONUTIL_API FSdGlobalObjectRegistry
+{
+public:
+	static constexpr int32 NumShards = 16;
+
+	struct FStats
+	{
+		int32  NumEntries = 0;
+		int32  NumStaleEntries = 0;
+		SIZE_T AllocatedBytes = 0;
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+	};
+
+	void Register(const FSdGlobalObjectHashKey& InHashKey, UObject* InObject);
+
+	UObject* Find(const FSdGlobalObjectHashKey& InHashKey) const;
+
+	bool Contains(const FSdGlobalObjectHashKey& InHashKey) const;
+
+	// Answers by class path only, never resolves or loads the class
+	bool ContainsSoft(const FSdGlobalObjectSoftHashKey& InSoftHashKey) const;
+
+	void Empty();
+
+	int32 Num() const;
+
+	// Visits every entry with its shard read-locked. The visitor must not call back into the registry
+	void ForEach(TFunctionRef<void(const FSdGlobalObjectHashKey&, UObject*)> Visitor) const;
+
+	// Reports the registered objects and their key classes, as the UPROPERTY map did before sharding
+	void AddReferencedObjects(FReferenceCollector& Collector);
+
+	// Entry counts, stale entries and allocated bytes across all shards, plus lookup hit counters
+	FStats GetStats() const;
+
+	// Snapshot of every entry, for code that read the RegisteredObjects map of the former USTRUCT. Copies the whole registry
+	UE_DEPRECATED(1.2, "RegisteredObjects is sharded and lock protected now, use Find, Contains or ForEach instead.")
+	TMap<FSdGlobalObjectHashKey, UObject*> GetRegisteredObjects() const;
+
+private:
+	// Cache line aligned so lookups on neighbouring shards never share a line, lock and counters included
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+
+		// Lookup counters live with their shard, GetStats sums them
+		mutable std::atomic<uint64> NumHits{ 0 };
+		mutable std::atomic<uint64> NumMisses{ 0 };
+
+		TMap<FSdGlobalObjectHashKey, TObjectPtr<UObject>> RegisteredObjects;
+
+		// Soft class path index of RegisteredObjects, lets callers query by TSoftClassPtr without loading the class
+		TSet<FSdGlobalObjectSoftHashKey> RegisteredClassPaths;
+	};
+
+	static int32 GetShardIndex(FName InClassName, FName InGlobalId)
+	{
+		return HashCombine(GetTypeHash(InClassName), GetTypeHash(InGlobalId)) % NumShards;
+	}
+
+	// The class name of a loaded class is the asset name of its path, so both keys of an entry map to the same shard
+	static int32 GetShardIndex(const FSdGlobalObjectHashKey& InHashKey)
+	{
+		return GetShardIndex(InHashKey.ObjectClass ? InHashKey.ObjectClass->GetFName() : NAME_None, InHashKey.GlobalId);
+	}
+
+	static int32 GetShardIndex(const FSdGlobalObjectSoftHashKey& InSoftHashKey)
+	{
+		return GetShardIndex(FName(*InSoftHashKey.ClassPath.GetAssetName()), InSoftHashKey.GlobalId);
+	}
+
+	template <typename KeyType>
+	FShard& GetShard(const KeyType& Key)
+	{
+		return Shards[GetShardIndex(Key)];
+	}
+
+	template <typename KeyType>
+	const FShard& GetShard(const KeyType& Key) const
+	{
+		return Shards[GetShardIndex(Key)];
+	}
+
+	FShard Shards[NumShards];
+};
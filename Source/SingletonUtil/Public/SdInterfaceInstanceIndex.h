@@ -0,0 +1,77 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/WeakObjectPtr.h"
+
+class ULevel;
+class UWorld;
+
+/**
+ * Per-world instances of the classes implementing the interfaces looked up through the class hash. An interface is
+ * indexed on first use by one pass over its implementing classes, keeping only the instances in this world's scope, so
+ * later misses never visit the instances of other worlds. Objects created afterwards are reported by the object array
+ * from any thread and sorted into the index on the next lookup. Objects of levels added to the world later are offered
+ * by the owner, since a streamed level only joins the world's scope once it is added. Everything is dropped when the
+ * set of registered classes changes.
+ * Game thread only, apart from the object creation listener.
+ */
+class SINGLETONUTIL_API FSdInterfaceInstanceIndex : public FUObjectArray::FUObjectCreateListener
+{
+public:
+	virtual ~FSdInterfaceInstanceIndex() override;
+
+	void Initialize(const UWorld* InWorld);
+
+	void Deinitialize();
+
+	// Returns the indexed instance with the lowest object index accepted by the filter, the one a full object array scan finds first
+	UObject* FindFirstInstance(const UClass* InInterfaceClass, TFunctionRef<bool(UObject*)> Filter);
+
+	// Offers every object inside a level that was just added to the world
+	void AddLevelObjects(const ULevel* InLevel);
+
+	// Drops every indexed interface, each is indexed again on its next lookup
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+	// Objects inside a level belong to the level's owning world. Streamed and World Partition levels live in a UWorld
+	// package of their own, so the typed outer world would be the sublevel's rather than the one they were added to.
+	// Objects outside any level (class defaults, assets, game instance owned objects) are global, unless they report
+	// another world through GetWorld, as multi-client PIE game instances do
+	static bool IsInWorldScope(const UObject* Object, const UWorld* InWorld);
+
+	//~ Begin FUObjectCreateListener
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+	//~ End FUObjectCreateListener
+
+private:
+	TMap<int32, FWeakObjectPtr>& IndexInterface(const UClass* InInterfaceClass);
+
+	// Sorts the objects created since the last lookup into the interfaces their class implements
+	void FlushCreatedObjects();
+
+	void AddIfInScope(UObject* InObject);
+
+	const UWorld* World = nullptr;
+
+	// In scope instances of every indexed interface, keyed by object index so a recycled index replaces its old entry
+	TMap<const UClass*, TMap<int32, FWeakObjectPtr>> InterfaceInstances;
+
+	// Indexed interfaces of every class implementing at least one of them. Read by the creation listener on any thread
+	TMap<const UClass*, TArray<const UClass*, TInlineAllocator<2>>> ClassInterfaces;
+	mutable FRWLock													ClassInterfacesLock;
+
+	// Object indices of the instances created since the last lookup
+	TArray<int32>			 CreatedObjectIndices;
+	mutable FCriticalSection CreatedObjectsCritical;
+
+	uint64 RegisteredClassesVersion = 0;
+
+	bool bListening = false;
+};
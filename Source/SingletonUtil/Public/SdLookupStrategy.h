@@ -0,0 +1,94 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/ObjectKey.h"
+#include "SdLookupStrategy.generated.h"
+
+/** How a singleton cache miss is resolved */
+UENUM(BlueprintType)
+enum class ESdLookupStrategy : uint8
+{
+	// Cheapest observed strategy for the key
+	Auto,
+	// Incrementally maintained resolution index, actors only
+	Index,
+	// Iterates the actors of the world, actors and components
+	WorldActorScan,
+	// Visits this world's instances of the classes implementing the key interface, indexed once through the per-class
+	// object hash and kept current as objects are created. Interfaces only
+	ClassHashScan,
+	// Visits every object of the global object array, interfaces only
+	ObjectArrayScan,
+	MAX UMETA(Hidden)
+};
+
+/** Lookup a strategy cost was measured for, the same class can be looked up as more than one kind */
+enum class ESdLookupKind : uint8
+{
+	Actor,
+	Component,
+	Interface,
+};
+
+/**
+ * Per-key cost of every lookup strategy, measured on cache misses, for one world.
+ * Each candidate strategy of a key is measured once, after which the cheapest one is used and the least sampled one
+ * is measured again every SingletonUtil.Lookup.ExploreInterval selections. SingletonUtil.Lookup.ForceStrategy overrides
+ * the selection. SingletonUtil.Lookup.ExploreBudgetMs is checked before every scan: a strategy other than the cheapest
+ * known one only runs when its expected cost fits in what is left of the frame's budget. Lookups return their singleton
+ * synchronously, so the scan answering a miss is never deferred or cut short, only the choice of strategy is budgeted.
+ * The actor resolution index is not selected here, it answers first whenever it tracks the class and its cost is
+ * recorded for the report.
+ */
+class SINGLETONUTIL_API FSdLookupStrategySelector
+{
+public:
+	static ESdLookupStrategy GetForcedStrategy();
+
+	// SingletonUtil.Lookup.DisableCache, every lookup resolves through a strategy instead of the caches and the index
+	static bool IsCacheDisabled();
+
+	// Candidates are in order of preference, the first one is used while nothing was measured
+	ESdLookupStrategy SelectStrategy(const UClass* InClass, ESdLookupKind InKind, TConstArrayView<ESdLookupStrategy> InCandidates);
+
+	void RecordCost(const UClass* InClass, ESdLookupKind InKind, ESdLookupStrategy InStrategy, float InMilliseconds);
+
+	// Average cost in milliseconds, negative when the strategy was never measured for the key
+	float GetAverageCost(const UClass* InClass, ESdLookupKind InKind, ESdLookupStrategy InStrategy) const;
+
+	int32 GetNumKeys() const { return KeyCosts.Num(); }
+
+	// Visits the measured strategies of every key, with their average cost in milliseconds and number of samples
+	void ForEachKeyCost(TFunctionRef<void(const UClass* InClass, ESdLookupKind InKind, ESdLookupStrategy InStrategy, float InAverageMilliseconds, uint32 InSamples)> Visitor) const;
+
+	void Reset();
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	// Milliseconds of SingletonUtil.Lookup.ExploreBudgetMs left this frame, the float max when unlimited
+	float GetRemainingExploreBudget();
+
+	struct FStrategyCost
+	{
+		float  AverageMilliseconds = 0.f;
+		uint32 Samples = 0;
+	};
+
+	struct FKeyCosts
+	{
+		FStrategyCost Costs[uint8(ESdLookupStrategy::MAX)];
+		uint32		  NumSelections = 0;
+	};
+
+	// Keys hold no strong reference, costs of a collected class are simply never found again
+	using FCostKey = TPair<TObjectKey<UClass>, ESdLookupKind>;
+
+	TMap<FCostKey, FKeyCosts> KeyCosts;
+
+	uint64 BudgetFrame = 0;
+	float  FrameScanMilliseconds = 0.f;
+};
@@ -0,0 +1,48 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * World independent class data shared by every USdSingletonSubsystem in the process: derived classes, interface
+ * implementers and class depths used to rank singleton actors. Built lazily on first use and refreshed when the set of
+ * registered classes changes, so memory and warm-up cost do not scale with the number of worlds.
+ * Game thread only.
+ */
+class SINGLETONUTIL_API FSdSingletonClassMetadata
+{
+public:
+	static FSdSingletonClassMetadata& Get();
+
+	// Direct subclasses of InClass. OutbCacheHit tells whether the list was already built
+	const TArray<UClass*>& GetDerivedClasses(const UClass* InClass, bool* OutbCacheHit = nullptr);
+
+	// Merges externally computed derived classes into the shared list
+	void AddDerivedClasses(const UClass* InClass, TConstArrayView<UClass*> InDerivedClasses);
+
+	// Every loaded, non-interface class implementing the interface
+	const TArray<const UClass*>& GetInterfaceImplementingClasses(const UClass* InInterfaceClass);
+
+	// Number of super classes above InClass
+	int32 GetClassDepth(const UClass* InClass);
+
+	int32 GetNumEntries() const;
+
+	// Visits every cached derived class list in place. The visitor must not query the metadata
+	void ForEachDerivedClassList(TFunctionRef<void(const UClass*, const TArray<UClass*>&)> Visitor) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	// Drops every list when a class was added or removed since they were built
+	void RefreshIfClassesChanged();
+
+	TMap<const UClass*, TArray<UClass*>> DerivedClasses;
+
+	TMap<const UClass*, TArray<const UClass*>> InterfaceImplementers;
+
+	TMap<const UClass*, int32> ClassDepths;
+
+	uint64 RegisteredClassesVersion = 0;
+};
@@ -0,0 +1,103 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/Interface.h"
+#include "Templates/SubclassOf.h"
+#include "SdSingletonInitialization.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class USdSingletonInitializable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * Implemented by native singleton actors and components with expensive initialization.
+ * USdSingletonSubsystem::InitializeSingletons spawns them in dependency order, runs PrepareSingleton of independent
+ * singletons concurrently on worker threads, then calls FinalizeSingleton on the game thread in dependency order.
+ * Both are called once per singleton instance.
+ */
+class SINGLETONUTIL_API ISdSingletonInitializable
+{
+	GENERATED_BODY()
+
+public:
+	// Called on the class default object. Dependencies added with USdSingletonSubsystem::AddSingletonDependency are added to these
+	virtual void GetSingletonDependencies(TArray<UClass*>& OutDependencies) const {}
+
+	// Worker thread, after the dependencies were prepared. Load data and build tables here, without touching the world or other singletons
+	virtual void PrepareSingleton() {}
+
+	// Game thread, after PrepareSingleton and after every dependency was finalized
+	virtual void FinalizeSingleton() {}
+};
+
+USTRUCT(BlueprintType)
+struct SINGLETONUTIL_API FSdSingletonDependencyList
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	TArray<TSubclassOf<UObject>> Dependencies;
+};
+
+USTRUCT(BlueprintType)
+struct SINGLETONUTIL_API FSdSingletonInitStep
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	TSubclassOf<UObject> SingletonClass;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	TObjectPtr<UObject> Singleton = nullptr;
+
+	// False if the singleton could not be created, or was already initialized by an earlier call
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	bool bInitialized = false;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	float SpawnMilliseconds = 0.f;
+
+	// Worker thread time
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	float PrepareMilliseconds = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	float FinalizeMilliseconds = 0.f;
+
+	// Longest chain of prepare and finalize time through the dependencies, ending with this singleton. Spawning runs
+	// serially for every singleton before any prepare work and is not part of it
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	float CriticalPathMilliseconds = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct SINGLETONUTIL_API FSdSingletonInitReport
+{
+	GENERATED_USTRUCT_BODY()
+
+public:
+	// In finalize order, every dependency comes before its dependents
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	TArray<FSdSingletonInitStep> Steps;
+
+	// The dependency chain with the most prepare and finalize time, first dependency to last dependent. Shorten this one to initialize faster
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	TArray<TSubclassOf<UObject>> CriticalPath;
+
+	// Classes in or depending on a dependency cycle. They are initialized last and their cyclic dependencies are ignored
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	TArray<TSubclassOf<UObject>> CyclicClasses;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	float TotalMilliseconds = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	float CriticalPathMilliseconds = 0.f;
+};
@@ -0,0 +1,90 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Opt-in attribution of singleton cache miss scans to their call sites, enabled by SingletonUtil.Attribution.Enable.
+ * Scans called from Blueprint are attributed to the calling Blueprint function and its bytecode offset, native scans
+ * to the first frame outside this plugin. Native frames are only captured as program counters and told apart by the
+ * address range of this plugin's module, nothing is symbolicated until a report is built. Monolithic builds, or
+ * platforms that cannot list their modules, key native scans by their whole stack instead and find the call site by
+ * name when the report is built. The full native stack of the first scan of a call site is kept as a sample.
+ * Process-wide and game thread only.
+ * SingletonUtil.Attribution.Report prints the call sites ranked by cumulative scan time, or writes them to a csv file.
+ */
+class SINGLETONUTIL_API FSdSingletonMissAttribution
+{
+public:
+	static FSdSingletonMissAttribution& Get();
+
+	static bool IsEnabled();
+
+	void RecordScan(const UClass* InKey, float InScanMilliseconds);
+
+	struct FCallSiteReport
+	{
+		FString CallSite;
+		// Symbolicated native stack of the first scan at this call site, empty for Blueprint call sites
+		FString SampleStack;
+		FString KeyName;
+		uint64	Scans = 0;
+		double	TotalMilliseconds = 0.0;
+	};
+
+	// Ranked by cumulative scan time, most expensive first. Native call sites are symbolicated here, which can take a while
+	TArray<FCallSiteReport> BuildReport() const;
+
+	void Reset();
+
+private:
+	static constexpr int32 MaxNativeFrames = 12;
+
+	// Only the call site itself is part of the key, callers further up the stack do not split it
+	struct FCallSiteKey
+	{
+		const UClass* Key = nullptr;
+		const void*	  ScriptFunction = nullptr;
+		int32		  ScriptCodeOffset = INDEX_NONE;
+		uint64		  NativeCallSite = 0;
+		// Whole native stack, only used when the plugin's module range is unknown
+		uint32 NativeStackHash = 0;
+
+		friend bool operator==(const FCallSiteKey& A, const FCallSiteKey& B)
+		{
+			return A.Key == B.Key && A.ScriptFunction == B.ScriptFunction && A.ScriptCodeOffset == B.ScriptCodeOffset && A.NativeCallSite == B.NativeCallSite && A.NativeStackHash == B.NativeStackHash;
+		}
+
+		friend uint32 GetTypeHash(const FCallSiteKey& CallSiteKey)
+		{
+			const uint32 SiteHash = HashCombine(GetTypeHash(CallSiteKey.ScriptFunction), GetTypeHash(CallSiteKey.ScriptCodeOffset));
+			const uint32 NativeHash = HashCombine(GetTypeHash(CallSiteKey.NativeCallSite), CallSiteKey.NativeStackHash);
+			return HashCombine(HashCombine(GetTypeHash(CallSiteKey.Key), SiteHash), NativeHash);
+		}
+	};
+
+	struct FCallSiteStats
+	{
+		// Names are taken when the call site is first seen, the classes and functions may be gone by report time
+		FString KeyName;
+		FString ScriptLocation;
+		uint64	SampleBackTrace[MaxNativeFrames] = {};
+		uint64	Scans = 0;
+		double	TotalMilliseconds = 0.0;
+	};
+
+	// First program counter of the back trace outside this plugin's module
+	uint64 FindNativeCallSite(const uint64* InBackTrace) const;
+
+	// Looks up the address range of the module this plugin is linked into, once
+	void InitPluginModuleRange();
+
+	TMap<FCallSiteKey, FCallSiteStats> CallSites;
+
+	// Empty in monolithic builds, where the plugin shares its module with the code calling it, and on platforms that
+	// cannot list their modules
+	uint64 PluginModuleBegin = 0;
+	uint64 PluginModuleEnd = 0;
+	bool   bPluginModuleRangeInitialized = false;
+};
@@ -0,0 +1,71 @@
+//$ Copyright 2023-24, Scott Dunbar - Hello Friend LLC - All Rights Reserved $//
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class UWorld;
+
+enum class ESdPrewarmKeyKind : uint8
+{
+	Actor,
+	Component,
+	Interface,
+};
+
+struct FSdPrewarmEntry
+{
+	ESdPrewarmKeyKind Kind = ESdPrewarmKeyKind::Actor;
+	FSoftClassPath	  ClassPath;
+	uint32			  Requests = 0;
+	uint32			  Misses = 0;
+	uint32			  Scans = 0;
+};
+
+/**
+ * Per-map record of which singleton keys were requested, and how often each missed the cache or needed a full scan.
+ * Recorded while SingletonUtil.Prewarm.Record is set, saved as a small text file per map, and replayed when the world
+ * begins play so the caches are warm before actors begin play.
+ * Files are written to Saved/SingletonUtil/Prewarm and read from Content/SingletonUtil/Prewarm first, then Saved.
+ */
+class SINGLETONUTIL_API FSdSingletonPrewarmProfile
+{
+public:
+	static bool	 IsRecordingEnabled();
+	static bool	 IsPrewarmEnabled();
+	static float GetPrewarmBudgetSeconds();
+
+	// Map name used for the profile file, PIE prefixes removed
+	static FString GetProfileMapName(const UWorld* InWorld);
+
+	// Profile file of the map, in Content when bContentDir is set, otherwise in Saved
+	static FString GetProfilePath(const FString& InMapName, bool bContentDir);
+
+	void RecordAccess(ESdPrewarmKeyKind InKind, const UClass* InClass, bool bMiss, bool bScan);
+
+	bool LoadForMap(const FString& InMapName);
+
+	// Merges the recorded counts into the map's existing file, so profiles accumulate over sessions
+	bool SaveForMap(const FString& InMapName);
+
+	// Entries ordered by misses then scans, most expensive first
+	const TArray<FSdPrewarmEntry>& GetEntries() const { return Entries; }
+
+	bool IsEmpty() const { return Entries.Num() == 0; }
+
+	void Reset();
+
+private:
+	bool LoadFromFile(const FString& InPath);
+
+	void SortEntries();
+
+	// Index of the entry in Entries, added if missing
+	int32 FindOrAddEntry(ESdPrewarmKeyKind InKind, const FSoftClassPath& InClassPath);
+
+	TArray<FSdPrewarmEntry> Entries;
+
+	// Recording is keyed by class pointer, the class path is only built once per key
+	TMap<TPair<uint8, const UClass*>, int32> RecordedEntryIndices;
+};
@@ -4,8 +4,16 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
 #include "Runtime/CoreUObject/Public/UObject/ObjectMacros.h"
 #include "Runtime/CoreUObject/Public/UObject/Interface.h"
+#include "SdGlobalObjectRegistry.h"
+#include "SdActorResolutionIndex.h"
+#include "SdInterfaceInstanceIndex.h"
+#include "SdLookupStrategy.h"
+#include "SdSingletonPrewarmProfile.h"
+#include "SdSingletonInitialization.h"
 #include "SdSingletonSubsystem.generated.h"
 
 
@@ -175,55 +183,55 @@ public:
 };
 
 
-USTRUCT(BlueprintType)
-struct FSdGlobalObjectHashKey
+// Access counters of one actor, component or interface cache entry, kept beside the public cache maps
+struct FSdSingletonCacheEntry
 {
-	GENERATED_USTRUCT_BODY()
+	FSdSingletonCacheEntry() {}
+	explicit FSdSingletonCacheEntry(float InScanMilliseconds)
+		: LastAccessFrame(GFrameCounter), ScanMilliseconds(InScanMilliseconds) {}
 
-public:
-	FSdGlobalObjectHashKey() {}
-	FSdGlobalObjectHashKey(TSubclassOf<UObject> InObjectClass)
-	{
-		ObjectClass = InObjectClass;
-	}
+	// Cache hits served by this entry since it was filled
+	uint32 Hits = 0;
 
-	FSdGlobalObjectHashKey(TSubclassOf<UObject> InObjectClass, FName InGlobalId)
+	// GFrameCounter of the last lookup that touched this entry
+	uint64 LastAccessFrame = 0;
+
+	// Cost of the scan that filled this entry
+	float ScanMilliseconds = 0.f;
+
+	void MarkHit()
 	{
-		ObjectClass = InObjectClass;
-		GlobalId = InGlobalId;
+		Hits++;
+		LastAccessFrame = GFrameCounter;
 	}
+};
 
-	UPROPERTY()
-	TSubclassOf<UObject> ObjectClass = UObject::StaticClass();
+// Non-owning view of one cache entry handed to cache visitors, only valid for the duration of the visit
+struct FSdSingletonCacheEntryView
+{
+	FName CacheName;
 
-	UPROPERTY()
+	// Key class for the actor, component, registry and derived class caches, interface class for the interface cache
+	const UClass* KeyClass = nullptr;
+
+	// Full key for the interface cache, nullptr otherwise
+	const FSD_SingletonInterfaceHashKey* InterfaceHashKey = nullptr;
+
+	// Global id of registry entries, NAME_None otherwise
 	FName GlobalId = NAME_None;
 
-	friend bool operator==(const FSdGlobalObjectHashKey& A, const FSdGlobalObjectHashKey& B)
-	{
-		return A.ObjectClass == B.ObjectClass && A.GlobalId == B.GlobalId;
-	}
+	// Cached object, nullptr for the derived class cache
+	const UObject* Object = nullptr;
 
-	friend uint32 GetTypeHash(const FSdGlobalObjectHashKey& Key)
-	{
-		const uint32 StartLocationHash = GetTypeHash(Key.ObjectClass);
-		const uint32 EndLocationHash = GetTypeHash(Key.GlobalId);
-		return HashCombine(StartLocationHash, EndLocationHash);
-	}
+	// Cached subclasses of KeyClass for the derived class cache, nullptr otherwise
+	const TArray<UClass*>* DerivedClasses = nullptr;
 
-	FString GetHashKeyDisplayName() const
-	{
-		FString OutDisplayName;
-		ObjectClass->GetName(OutDisplayName);
-		if (GlobalId != NAME_None)
-		{
-			OutDisplayName = OutDisplayName.Append(TEXT("_"));
-			OutDisplayName = OutDisplayName.Append(GlobalId.ToString());
-		}
-		return OutDisplayName;
-	}
+	// Hit counter, last access frame and scan cost. Only entries the actor, component and interface lookups filled
+	// track them, nullptr for anything else
+	const FSdSingletonCacheEntry* Entry = nullptr;
 };
 
+// Deprecated, only kept as the value type of the deprecated USdSingletonSubsystem::CacheMap
 USTRUCT(BlueprintType)
 struct SINGLETONUTIL_API FSdDerivedClassCache
 {
@@ -235,15 +243,48 @@ public:
 };
 
 USTRUCT(BlueprintType)
-struct SINGLETONUTIL_API FSdGlobalObjectRegistry
+struct SINGLETONUTIL_API FSdSingletonCacheStats
 {
 	GENERATED_USTRUCT_BODY()
 
 public:
-	UPROPERTY()
-		TMap<FSdGlobalObjectHashKey, UObject*> RegisteredObjects;
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	FName CacheName;
+
+	// True for process-wide caches shared by every world subsystem
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	bool bSharedAcrossWorlds = false;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	int32 NumEntries = 0;
+
+	// Entries whose cached object has been destroyed or garbage collected
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	int32 NumStaleEntries = 0;
+
+	// Heap bytes owned by the cache container and its keys/values
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	int64 AllocatedBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	int64 Hits = 0;
+
+	UPROPERTY(BlueprintReadOnly, VisibleInstanceOnly, Category = "SingletonUtil")
+	int64 Misses = 0;
+
+	float GetHitRate() const
+	{
+		const int64 Lookups = Hits + Misses;
+		return Lookups > 0 ? float(double(Hits) / double(Lookups)) : 0.f;
+	}
 };
 
+DECLARE_DYNAMIC_DELEGATE_OneParam(FSdOnGlobalObjectResolved, UObject*, Object);
+
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FSdOnSingletonAvailability, UObject*, Singleton, bool, bAvailable);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FSdOnSingletonAvailabilityChanged, UClass*, Key, UObject*, Singleton, bool, bAvailable);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FSdOnSingletonAvailabilityNative, UObject* /*Singleton*/, bool /*bAvailable*/);
+
 /**
  * SingletonUtil
  */
@@ -253,8 +294,12 @@ class SINGLETONUTIL_API USdSingletonSubsystem : public UWorldSubsystem
 	GENERATED_BODY()
 public:
 	virtual void PostInitialize() override;
+	virtual void Deinitialize() override;
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 	UPROPERTY()
 	TMap<TSubclassOf<UObject>, AActor*> SingletonActorCacheMap;
 
@@ -264,18 +309,30 @@ public:
 	UPROPERTY()
 	TMap<FSD_SingletonInterfaceHashKey, UObject*> SingletonInterfaceCacheMap;
 
-	UPROPERTY()
+	// Sharded and lock protected, see FSdGlobalObjectRegistry. Referenced through AddReferencedObjects
 	FSdGlobalObjectRegistry GlobalObjectRegistry;
 
+	// Mirror of the derived classes this world looked up, for code still reading it. Filled once per class and refreshed
+	// when lookup results are merged in, so it may lag behind a class list rebuilt since. Will be removed in the next release
+	UE_DEPRECATED(1.2, "Derived classes are kept in the process-wide FSdSingletonClassMetadata, use K2_GetDerivedClassesFromClass instead.")
 	UPROPERTY()
 	TMap<TSubclassOf<UObject>, FSdDerivedClassCache> CacheMap;
 
+	// Derived classes are kept in the process-wide FSdSingletonClassMetadata, shared by every world
 	UFUNCTION()
 	void CacheLookupResult(TSubclassOf<UObject> Class, TArray<UClass*> Results);
 
 	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
 	void ClearLookupCache();
 
+	/**
+	 * Merges the singleton keys this world requested while SingletonUtil.Prewarm.Record was set into the map's
+	 * prewarm profile. Also done automatically when the world is torn down.
+	 * @return True if a profile file was written.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	bool SavePrewarmProfile();
+
 	// SINGLETON ACTOR FUNCTIONS
 
 	/**
@@ -330,8 +387,95 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Singleton Util", DisplayName = "Get Singleton Interface", meta = (DeterminesOutputType = InClass))
 	TScriptInterface<UInterface> K2_GetSingletonInterface(TSubclassOf<UInterface> InClass, UObject*& OutObject, const FSD_SingletonSearchParams& SearchParams = FSD_SingletonSearchParams(), bool bIgnoreCache = false);
 
+	/**
+	 * Sets how the singleton actor of a class is chosen when several actors of that class exist.
+	 * Clears the cached actor for the class so the next lookup applies the new policy.
+	 * @param InClass - The actor class the policy applies to. Subclasses requested directly use their own policy.
+	 * @param InPolicy - The resolution policy to use.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void SetActorResolutionPolicy(TSubclassOf<AActor> InClass, ESdActorResolutionPolicy InPolicy);
+
+	/**
+	 * Sets the resolution policy for every actor class without its own policy. Clears the actor cache.
+	 * @param InPolicy - The resolution policy to use.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void SetDefaultActorResolutionPolicy(ESdActorResolutionPolicy InPolicy);
+
+	/**
+	 * Sets the actor tag preferred by the Tagged resolution policy. Defaults to "Singleton". Clears the actor cache.
+	 * @param InTag - The actor tag marking the preferred singleton instance.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void SetPreferredActorTag(FName InTag);
+
+	// SINGLETON INITIALIZATION FUNCTIONS
+
+	/**
+	 * Declares that a singleton must be initialized after another one by InitializeSingletons.
+	 * Native singletons can also declare their dependencies through ISdSingletonInitializable.
+	 * @param InSingletonClass - The dependent singleton actor or component class.
+	 * @param InDependencyClass - The singleton actor or component class it depends on.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void AddSingletonDependency(TSubclassOf<UObject> InSingletonClass, TSubclassOf<UObject> InDependencyClass);
+
+	/**
+	 * Gets or creates the singleton actors and components and their dependencies, in dependency order.
+	 * ISdSingletonInitializable singletons are prepared concurrently on worker threads and finalized on the game thread
+	 * once their dependencies are finalized. Blocks until every singleton is finalized.
+	 * @param InSingletonClasses - The singleton actor or component classes to initialize.
+	 * @return Per singleton timings and the critical path of the initialization.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	FSdSingletonInitReport InitializeSingletons(const TArray<TSubclassOf<UObject>>& InSingletonClasses);
+
+	// SINGLETON AVAILABILITY FUNCTIONS
+
+	// Fires for every watched key when its singleton becomes available or goes away
+	UPROPERTY(BlueprintAssignable, Category = "SingletonUtil")
+	FSdOnSingletonAvailabilityChanged OnSingletonAvailabilityChanged;
+
+	/**
+	 * Subscribes to the availability of a singleton instead of polling for it every tick.
+	 * The event fires once when a matching singleton is spawned, registered or found, and again when it goes away.
+	 * If the singleton is already available the event fires immediately. Only lookups with default search params report
+	 * what they find. Interface keys implemented by objects other than actors and their components are reported when a
+	 * lookup or watch finds them, not when they are created.
+	 * @param InKey - An actor, component or interface class, or any other class for global registry objects.
+	 * @param OnAvailabilityChanged - Called with the singleton and whether it became available or went away.
+	 * @param InGlobalId - Optional ID of the global registry object to watch, ignored for actor, component and interface keys.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void WatchSingletonAvailability(UClass* InKey, FSdOnSingletonAvailability OnAvailabilityChanged, FName InGlobalId = NAME_None);
+
+	/**
+	 * Removes a subscription added with WatchSingletonAvailability.
+	 * @param InKey - The key the event was watching.
+	 * @param OnAvailabilityChanged - The event to remove.
+	 * @param InGlobalId - The global registry ID the event was watching.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void UnwatchSingletonAvailability(UClass* InKey, FSdOnSingletonAvailability OnAvailabilityChanged, FName InGlobalId = NAME_None);
+
+	/**
+	 * Checks whether a watched singleton is currently available, without performing a lookup.
+	 * @param InKey - The watched key.
+	 * @param InGlobalId - The watched global registry ID.
+	 * @return True if the key is watched and its singleton is alive.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "SingletonUtil")
+	bool IsSingletonAvailable(UClass* InKey, FName InGlobalId = NAME_None) const;
+
+	// C++ variants of the above, the delegate fires immediately if the singleton is already available
+	FDelegateHandle AddSingletonAvailabilityHandler(const UClass* InKey, FSdOnSingletonAvailabilityNative::FDelegate&& InDelegate, FName InGlobalId = NAME_None);
+	void			RemoveSingletonAvailabilityHandler(const UClass* InKey, FDelegateHandle InHandle, FName InGlobalId = NAME_None);
+
 	// SINGLETON UOBJECT FUNCTIONS
 
+	// The global registry functions below may be called from any thread, including the async loading thread and task graph workers
+
 	/**
 	 * Checks if a global object of the specified class is registered in the global registry.
 	 * @param InObjectClass - The class type of the object to check.
@@ -368,6 +512,27 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
 	bool IsGlobalObjectInRegistrySoft(TSoftClassPtr<UObject> InObjectClass, FName InGlobalId = NAME_None);
 
+	/**
+	 * Registers a global object under a soft class. If the class is not loaded yet it is streamed in asynchronously
+	 * through the streamable manager and the object is registered once the load completes.
+	 * @param InObjectClass - The soft class representing the object's class.
+	 * @param InObject - The object instance to register.
+	 * @param InGlobalId - Optional ID to identify the specific global object.
+	 * @param OnRegistered - Called with the registered object, or nullptr if the class or object could not be resolved.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void RegisterGlobalObjectInRegistryAsync(TSoftClassPtr<UObject> InObjectClass, UObject* InObject, FName InGlobalId, FSdOnGlobalObjectResolved OnRegistered);
+
+	/**
+	 * Retrieves a global object from the registry by soft class without blocking on I/O.
+	 * If an async registration for the same key is still in flight, the callback is deferred until it completes.
+	 * @param InObjectClass - The soft class representing the object's class.
+	 * @param InGlobalId - Optional ID to identify the specific global object.
+	 * @param OnResolved - Called with the registered object, or nullptr if none is registered.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SingletonUtil")
+	void GetGlobalObjectInRegistryAsync(TSoftClassPtr<UObject> InObjectClass, FName InGlobalId, FSdOnGlobalObjectResolved OnResolved);
+
 	// DEBUG FUNCTIONS
 
 	/**
@@ -390,4 +555,171 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "SingletonUtil|Debug")
 	TMap<FSD_SingletonInterfaceHashKey, UObject*> DebugGetInterfaceCacheSnapshot();
+
+	/**
+	 * Retrieves entry counts, stale entries, allocated bytes and hit/miss counters for every cache in this subsystem.
+	 * The same data is printed for all worlds by the SingletonUtil.CacheReport console command.
+	 * @return One entry per cache.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "SingletonUtil|Debug")
+	TArray<FSdSingletonCacheStats> GetCacheStats() const;
+
+	/**
+	 * Visits every entry of the actor, component and interface caches in place, with its live hit counter,
+	 * last access frame and scan cost, followed by the global object registry and the shared derived class cache.
+	 * Nothing is copied or allocated per entry, so this is safe to call every frame on a live session. Registry
+	 * shards stay read-locked while they are visited, so the visitor must not modify or query any cache.
+	 */
+	void ForEachCacheEntry(TFunctionRef<void(const FSdSingletonCacheEntryView&)> Visitor) const;
+
+	// Measured cost of every miss strategy per key, also printed by SingletonUtil.CacheReport
+	const FSdLookupStrategySelector& GetLookupStrategySelector() const { return LookupStrategySelector; }
+
+private:
+	void OnActorSpawned(AActor* InActor);
+	void OnActorDestroyed(AActor* InActor);
+
+	// Streamed actors never pass through OnActorSpawned, so adding or removing a level of this world drops the cached
+	// singletons and tracked candidates of every class its actors could answer for
+	void OnLevelChanged(ULevel* InLevel, UWorld* InWorld);
+	void OnLevelAdded(ULevel* InLevel, UWorld* InWorld);
+
+	enum class ESdAvailabilityKeyKind : uint8
+	{
+		Actor,
+		Component,
+		Interface,
+		GlobalObject,
+	};
+
+	// A watched class, plus the registry ID for global object keys. Every other kind of key uses NAME_None
+	struct FSdAvailabilityKey
+	{
+		const UClass* Class = nullptr;
+		FName		  GlobalId = NAME_None;
+
+		bool operator==(const FSdAvailabilityKey& Other) const
+		{
+			return Class == Other.Class && GlobalId == Other.GlobalId;
+		}
+
+		friend uint32 GetTypeHash(const FSdAvailabilityKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Class), GetTypeHash(Key.GlobalId));
+		}
+	};
+
+	struct FSdAvailabilityWatch
+	{
+		ESdAvailabilityKeyKind				KeyKind = ESdAvailabilityKeyKind::GlobalObject;
+		TWeakObjectPtr<UObject>				Current;
+		TArray<FSdOnSingletonAvailability>	BlueprintEvents;
+		FSdOnSingletonAvailabilityNative	NativeEvent;
+	};
+
+	static ESdAvailabilityKeyKind GetAvailabilityKeyKind(const UClass* InKey);
+
+	static FSdAvailabilityKey MakeAvailabilityKey(const UClass* InKey, FName InGlobalId);
+
+	TSharedRef<FSdAvailabilityWatch> FindOrAddAvailabilityWatch(const FSdAvailabilityKey& InKey);
+
+	UObject* FindAvailableSingleton(const FSdAvailabilityKey& InKey, ESdAvailabilityKeyKind InKeyKind);
+
+	// Lookups report what they found under NAME_None, the registry under the ID it was given
+	void NotifySingletonFound(const FSdAvailabilityKey& InKey, UObject* InSingleton);
+	void NotifySingletonLost(const FSdAvailabilityKey& InKey);
+	void BroadcastAvailability(const FSdAvailabilityKey& InKey, FSdAvailabilityWatch& InWatch, UObject* InSingleton, bool bAvailable);
+
+	// Shared so a watch stays alive while its subscribers run
+	TMap<FSdAvailabilityKey, TSharedRef<FSdAvailabilityWatch>> AvailabilityWatches;
+
+	// Set once the first key is watched. Read from any thread, off-thread registrations skip the game thread hop while it is false
+	std::atomic<bool> bHasAvailabilityWatches{ false };
+
+	// Resolves lost keys again once their singleton is gone, and reports watched singletons destroyed without an actor
+	// destroyed event, such as components removed through DestroyComponent. Registered while any key is watched
+	bool TickAvailabilityWatches(float DeltaTime);
+
+	FTSTicker::FDelegateHandle AvailabilityTickerHandle;
+
+	// Keys that lost their singleton, resolved again on the next tick when the destroyed object no longer matches
+	TArray<FSdAvailabilityKey, TInlineAllocator<8>> LostAvailabilityKeys;
+
+	FDelegateHandle ActorDestroyedHandle;
+
+	FSdActorResolutionIndex ActorResolutionIndex;
+
+	// This world's instances of the classes implementing the interfaces looked up through the class hash
+	FSdInterfaceInstanceIndex InterfaceInstanceIndex;
+
+	// Observed cost of each miss strategy per key, kept when the caches are cleared
+	FSdLookupStrategySelector LookupStrategySelector;
+
+	FDelegateHandle ActorSpawnedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+
+	struct FSdCacheCounters
+	{
+		uint64 Hits = 0;
+		uint64 Misses = 0;
+	};
+
+	FSdCacheCounters DerivedClassCacheCounters;
+
+	// Copies the shared derived class list into the deprecated CacheMap, goes away with it. Lookups only copy on the
+	// first access per class, bOverwrite refreshes an existing entry
+	void MirrorToDeprecatedCacheMap(TSubclassOf<UObject> Class, const TArray<UClass*>& ChildClasses, bool bOverwrite = false);
+	FSdCacheCounters ActorCacheCounters;
+	FSdCacheCounters ComponentCacheCounters;
+	FSdCacheCounters InterfaceCacheCounters;
+
+	// Access counters of the entries the lookups put in the public cache maps, under the same keys. Entries added
+	// from outside have none and are reported as untracked
+	TMap<TSubclassOf<UObject>, FSdSingletonCacheEntry>		   ActorCacheEntries;
+	TMap<TSubclassOf<UObject>, FSdSingletonCacheEntry>		   ComponentCacheEntries;
+	TMap<FSD_SingletonInterfaceHashKey, FSdSingletonCacheEntry> InterfaceCacheEntries;
+
+	void OnGlobalObjectClassLoaded(FSdGlobalObjectSoftHashKey SoftHashKey, TWeakObjectPtr<UObject> WeakObject, FSdOnGlobalObjectResolved OnRegistered);
+
+	// In-flight async registrations per soft key, queries for these keys wait until they complete
+	TMap<FSdGlobalObjectSoftHashKey, int32> PendingGlobalObjectRegistrations;
+
+	TMap<FSdGlobalObjectSoftHashKey, TArray<FSdOnGlobalObjectResolved>> PendingGlobalObjectQueries;
+
+	void RecordPrewarmAccess(ESdPrewarmKeyKind InKind, const UClass* InClass, bool bMiss, bool bScan)
+	{
+		if (!bRunningPrewarm && FSdSingletonPrewarmProfile::IsRecordingEnabled())
+		{
+			RecordedPrewarmProfile.RecordAccess(InKind, InClass, bMiss, bScan);
+		}
+	}
+
+	// Loads the map's profile and resolves its most expensive keys before any actor begins play, the rest are
+	// resolved over the following frames while streaming levels come in
+	void StartPrewarm();
+
+	bool TickPrewarm(float DeltaTime);
+
+	// Resolves profile keys until the budget is spent, a negative budget resolves all of them
+	void RunPrewarm(double BudgetSeconds);
+
+	void StopPrewarm();
+
+	// Keys requested by this world while recording, merged into the map's profile when saved
+	FSdSingletonPrewarmProfile RecordedPrewarmProfile;
+
+	// The map's profile being replayed, PrewarmCursor is the next entry to resolve
+	FSdSingletonPrewarmProfile PrewarmProfile;
+	int32					   PrewarmCursor = 0;
+	bool					   bRunningPrewarm = false;
+
+	FTSTicker::FDelegateHandle PrewarmTickerHandle;
+
+	UPROPERTY()
+	TMap<TSubclassOf<UObject>, FSdSingletonDependencyList> SingletonDependencies;
+
+	// Singletons already prepared and finalized, so they are only initialized once. Destroyed actors and their
+	// components are removed as they go, anything else destroyed is dropped on the next InitializeSingletons call
+	TSet<FObjectKey> InitializedSingletons;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "SdSingletonSubsystem.h"
 #include "SingletonUtilBPLibrary.generated.h"
 
 
@@ -62,4 +63,16 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Singleton Util", DisplayName = "Get Singleton Interface", meta = (WorldContext = "WorldContextObject", DeterminesOutputType = InterfaceClass))
 	static TScriptInterface<UInterface> K2_GetSingletonInterface(UObject* WorldContextObject, TSubclassOf<UInterface> InterfaceClass, UObject*& OutObject);
+
+	/**
+	 * Subscribes to the availability of a singleton actor, component, interface or global object in the current world,
+	 * so you do not need to poll Get Singleton on tick. Fires once when the singleton appears and again when it goes away.
+	 * If it is already available the event fires immediately.
+	 *
+	 * @param WorldContextObject      The world context object, used to find the world's singleton subsystem.
+	 * @param Key                     The actor, component or interface class to watch.
+	 * @param OnAvailabilityChanged   Called with the singleton and whether it became available or went away.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Singleton Util", DisplayName = "Watch Singleton Availability", meta = (WorldContext = "WorldContextObject"))
+	static void K2_WatchSingletonAvailability(UObject* WorldContextObject, UClass* Key, FSdOnSingletonAvailability OnAvailabilityChanged);
 };
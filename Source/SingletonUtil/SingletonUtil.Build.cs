@@ -49,5 +49,8 @@ public class SingletonUtil : ModuleRules
 				// ... add any modules that your module loads dynamically here ...
 			}
 			);
+
+		// registers the SingletonUtil gameplay debugger category where the gameplay debugger is available
+		SetupGameplayDebuggerSupport(Target);
 	}
 }